@@ -0,0 +1,146 @@
+#ifndef TFW_ALGORITHM_H
+#define TFW_ALGORITHM_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "TFW_errorno.h"
+#include "TFW_parallel.h"
+
+namespace TFW {
+
+// ============================================================================
+// 并行算法的C++封装：任意可调用对象经由TFW_Parallel*在框架默认执行器上执行
+// C++ wrappers of TFW_Parallel*: any callable runs fork-join on the framework default executor
+// ============================================================================
+
+// 不足两段时直接串行排序，与C实现一致
+constexpr size_t TFW_PARALLEL_SORT_MIN_RUN = 2048;
+
+/**
+ * 并行处理[begin, end)，fn可接收区间fn(size_t begin, size_t end)或单个下标fn(size_t i)
+ * Process [begin, end) in parallel; fn takes either a chunk (begin, end) or a single index
+ * @param grain 最小切分粒度，0表示自动 / Minimum chunk size, 0 for automatic
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+template <typename F>
+int32_t TFW_ParallelFor(size_t begin, size_t end, size_t grain, F&& fn) {
+    using Fn = std::remove_reference_t<F>;
+    return ::TFW_ParallelFor(begin, end, grain, [](size_t chunkBegin, size_t chunkEnd, uint32_t, void* arg) {
+        Fn& body = *static_cast<Fn*>(arg);
+        if constexpr (std::is_invocable_v<Fn&, size_t, size_t>) {
+            body(chunkBegin, chunkEnd);
+        } else {
+            for (size_t i = chunkBegin; i < chunkEnd; i++) {
+                body(i);
+            }
+        }
+    }, const_cast<std::remove_const_t<Fn>*>(&fn));
+}
+
+/**
+ * 并行归约：每个参与者以identity为初值调用chunk(begin, end, acc)累积，最后用combine(acc, partial)合并
+ * Parallel reduce: each participant folds chunks from identity, partials are merged with combine
+ * @param identity 单位元 / Identity value
+ * @param chunk T(size_t begin, size_t end, T acc) / Chunk fold
+ * @param combine T(T acc, T partial)，须满足结合律与交换律 / Associative and commutative combine
+ * @return 归约结果 / Reduced value
+ */
+template <typename T, typename ChunkFn, typename CombineFn>
+T TFW_ParallelReduce(size_t begin, size_t end, size_t grain, T identity, ChunkFn&& chunk, CombineFn&& combine) {
+    using Chunk = std::remove_reference_t<ChunkFn>;
+    struct Context {
+        Chunk& chunk;
+        std::vector<T> partials;
+    };
+    Context context = { chunk, std::vector<T>(TFW_ParallelConcurrency(), identity) };
+    (void)::TFW_ParallelFor(begin, end, grain, [](size_t chunkBegin, size_t chunkEnd, uint32_t slot, void* arg) {
+        Context& ctx = *static_cast<Context*>(arg);
+        ctx.partials[slot] = ctx.chunk(chunkBegin, chunkEnd, std::move(ctx.partials[slot]));
+    }, &context);
+    T result = std::move(identity);
+    for (T& partial : context.partials) {
+        result = combine(std::move(result), std::move(partial));
+    }
+    return result;
+}
+
+// 合并结果前k个元素中来自左段[left, left + leftCnt)的个数，相等时左段在前
+template <typename It, typename Compare>
+size_t TFW_MergeSplit(It left, size_t leftCnt, It right, size_t rightCnt, size_t k, Compare& comp) {
+    size_t low = (k > rightCnt) ? k - rightCnt : 0;
+    size_t high = std::min(k, leftCnt);
+    while (low < high) {
+        size_t i = low + (high - low) / 2;
+        if (!comp(right[k - i - 1], left[i])) {
+            low = i + 1;
+        } else {
+            high = i;
+        }
+    }
+    return low;
+}
+
+/**
+ * 并行归并排序：分段并行std::sort后逐层归并，段数不足时每对段按合并位置切分，各层都能并行；
+ * 需要与区间等大的临时缓冲，元素须可移动构造与移动赋值，不保证稳定
+ * Parallel merge sort: runs are sorted in parallel, then every merge level is split across participants
+ * @param first 随机访问迭代器 / Random-access iterator
+ * @param last 结束迭代器 / End iterator
+ * @param comp 比较函数 / Comparator
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+template <typename It, typename Compare = std::less<>>
+int32_t TFW_ParallelSort(It first, It last, Compare comp = Compare()) {
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+        typename std::iterator_traits<It>::iterator_category>, "TFW_ParallelSort needs random-access iterators");
+    using Value = typename std::iterator_traits<It>::value_type;
+    size_t count = static_cast<size_t>(last - first);
+    size_t slotCnt = TFW_ParallelConcurrency();
+    if (slotCnt == 1 || count < TFW_PARALLEL_SORT_MIN_RUN * 2) {
+        std::sort(first, last, comp);
+        return TFW_SUCCESS;
+    }
+    size_t width = std::max((count + slotCnt - 1) / slotCnt, TFW_PARALLEL_SORT_MIN_RUN);
+    int32_t ret = TFW_ParallelFor(0, (count + width - 1) / width, 1, [&](size_t run) {
+        size_t lo = run * width;
+        std::sort(first + lo, first + std::min(lo + width, count), comp);
+    });
+    std::vector<Value> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+    // 缓冲与原区间交替作为归并的源和目的
+    bool inBuffer = true;
+    for (; ret == TFW_SUCCESS && width < count; width *= 2) {
+        size_t pairCnt = (count + width * 2 - 1) / (width * 2);
+        size_t parts = (pairCnt < slotCnt) ? (slotCnt + pairCnt - 1) / pairCnt : 1;
+        auto mergeLevel = [&](auto src, auto dst) {
+            return TFW_ParallelFor(0, pairCnt * parts, 1, [&](size_t task) {
+                size_t lo = (task / parts) * width * 2;
+                size_t mid = std::min(lo + width, count);
+                size_t hi = std::min(mid + width, count);
+                size_t begin = (hi - lo) * (task % parts) / parts;
+                size_t end = (hi - lo) * (task % parts + 1) / parts;
+                size_t i = TFW_MergeSplit(src + lo, mid - lo, src + mid, hi - mid, begin, comp);
+                size_t iEnd = TFW_MergeSplit(src + lo, mid - lo, src + mid, hi - mid, end, comp);
+                std::merge(std::make_move_iterator(src + lo + i), std::make_move_iterator(src + lo + iEnd),
+                    std::make_move_iterator(src + mid + (begin - i)), std::make_move_iterator(src + mid + (end - iEnd)),
+                    dst + lo + begin, comp);
+            });
+        };
+        ret = inBuffer ? mergeLevel(buffer.begin(), first) : mergeLevel(first, buffer.begin());
+        inBuffer = !inBuffer;
+    }
+    if (inBuffer) {
+        std::move(buffer.begin(), buffer.end(), first);
+    }
+    return ret;
+}
+
+} // namespace TFW
+
+#endif // TFW_ALGORITHM_H
@@ -0,0 +1,287 @@
+#ifndef TFW_COROUTINE_H
+#define TFW_COROUTINE_H
+
+#if defined(__cpp_impl_coroutine)
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <utility>
+
+#include "TFW_errorno.h"
+#include "TFW_future.h"
+#include "TFW_message_loop.h"
+#include "TFW_task.h"
+
+namespace TFW {
+
+// ============================================================================
+// 协程支持：返回TFW_Future<T>的函数可作为协程，co_await切换looper、等待定时器或等待其他Future
+// Coroutine support: functions returning TFW_Future<T> may be coroutines that hop loopers,
+// sleep on the looper timer queue and await other futures. Requires TFW_ENABLE_COROUTINES.
+// ============================================================================
+
+// 协程帧池：按64字节分级缓存在线程本地链表，超出上限或超大帧走全局分配
+// Frame pool: per-thread free lists in 64-byte classes, larger frames use the global allocator
+class TFW_CoroutineFramePool {
+public:
+    static constexpr size_t CLASS_SIZE = 64;
+    static constexpr size_t CLASS_CNT = 16;
+    static constexpr uint32_t CACHE_MAX = 32;
+
+    static void* Allocate(size_t size) noexcept {
+        size_t index = ClassOf(size);
+        if (index >= CLASS_CNT) {
+            return ::operator new(size, std::nothrow);
+        }
+        Cache& cache = LocalCache();
+        FreeBlock* block = cache.heads[index];
+        if (block != nullptr) {
+            cache.heads[index] = block->next;
+            cache.counts[index]--;
+            return block;
+        }
+        return ::operator new((index + 1) * CLASS_SIZE, std::nothrow);
+    }
+
+    // 协程可能在另一个looper上结束，帧归还到释放线程的缓存
+    static void Free(void* ptr, size_t size) noexcept {
+        size_t index = ClassOf(size);
+        if (index >= CLASS_CNT) {
+            ::operator delete(ptr);
+            return;
+        }
+        Cache& cache = LocalCache();
+        if (cache.counts[index] >= CACHE_MAX) {
+            ::operator delete(ptr);
+            return;
+        }
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->next = cache.heads[index];
+        cache.heads[index] = block;
+        cache.counts[index]++;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct Cache {
+        FreeBlock* heads[CLASS_CNT] = {};
+        uint32_t counts[CLASS_CNT] = {};
+
+        ~Cache() {
+            for (FreeBlock*& head : heads) {
+                while (head != nullptr) {
+                    FreeBlock* next = head->next;
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+        }
+    };
+
+    static size_t ClassOf(size_t size) {
+        return (size == 0) ? 0 : (size - 1) / CLASS_SIZE;
+    }
+
+    static Cache& LocalCache() {
+        thread_local Cache cache;
+        return cache;
+    }
+};
+
+// 协程立即开始执行，结束时帧立即释放；结果写入返回的TFW_Future
+template <typename T>
+class TFW_CoroutinePromiseBase {
+public:
+    static void* operator new(size_t size) noexcept {
+        return TFW_CoroutineFramePool::Allocate(size);
+    }
+
+    static void operator delete(void* ptr, size_t size) noexcept {
+        TFW_CoroutineFramePool::Free(ptr, size);
+    }
+
+    static TFW_Future<T> get_return_object_on_allocation_failure() {
+        return TFW_MakeErrorFuture<T>(TFW_ERROR_MALLOC_ERR);
+    }
+
+    TFW_Future<T> get_return_object() {
+        return promise_.GetFuture();
+    }
+
+    std::suspend_never initial_suspend() noexcept {
+        return {};
+    }
+
+    std::suspend_never final_suspend() noexcept {
+        return {};
+    }
+
+    void unhandled_exception() noexcept {
+        std::terminate();
+    }
+
+protected:
+    TFW_Promise<T> promise_;
+};
+
+template <typename T>
+class TFW_CoroutinePromise : public TFW_CoroutinePromiseBase<T> {
+public:
+    template <typename U>
+    void return_value(U&& value) {
+        this->promise_.SetValue(std::forward<U>(value));
+    }
+};
+
+template <>
+class TFW_CoroutinePromise<void> : public TFW_CoroutinePromiseBase<void> {
+public:
+    void return_void() {
+        this->promise_.SetValue();
+    }
+};
+
+// co_await TFW_ResumeOn / TFW_Delay的等待体：恢复动作作为闭包消息投递到looper
+class TFW_LooperAwaiter {
+public:
+    TFW_LooperAwaiter(const TFW_Looper* looper, uint64_t delayMillis) : looper_(looper), delayMillis_(delayMillis) {}
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    // 投递成功后协程可能已在looper线程上恢复，之后不能再访问this
+    bool await_suspend(std::coroutine_handle<> handle) noexcept {
+        TFW_LooperAwaiter*& posting = Posting();
+        TFW_LooperAwaiter* prev = posting;
+        posting = this;
+        int32_t ret = TFW_PostTask(looper_, Resume(handle, this), delayMillis_);
+        posting = prev;
+        if (ret != TFW_SUCCESS) {
+            status_ = ret;
+            return false;
+        }
+        return true;
+    }
+
+    // TFW_SUCCESS表示已在目标looper上恢复，否则协程在投递或释放消息的线程上恢复
+    int32_t await_resume() const noexcept {
+        return status_;
+    }
+
+private:
+    // 消息执行时在looper上恢复；未执行即被释放(移除、取消、looper销毁)时以错误恢复，协程不会悬挂
+    class Resume {
+    public:
+        Resume(std::coroutine_handle<> handle, TFW_LooperAwaiter* awaiter) : handle_(handle), awaiter_(awaiter) {}
+
+        Resume(Resume&& other) noexcept
+            : handle_(std::exchange(other.handle_, nullptr)), awaiter_(other.awaiter_) {}
+
+        Resume(const Resume&) = delete;
+        Resume& operator=(const Resume&) = delete;
+        Resume& operator=(Resume&&) = delete;
+
+        ~Resume() {
+            if (handle_ == nullptr) {
+                return;
+            }
+            // 投递失败时消息在await_suspend内同步释放，由await_suspend返回false继续执行
+            if (awaiter_ == Posting()) {
+                return;
+            }
+            awaiter_->status_ = TFW_ERROR_LOOPER_ERROR;
+            std::exchange(handle_, nullptr).resume();
+        }
+
+        void operator()() {
+            awaiter_->status_ = TFW_SUCCESS;
+            std::exchange(handle_, nullptr).resume();
+        }
+
+    private:
+        std::coroutine_handle<> handle_;
+        TFW_LooperAwaiter* awaiter_;
+    };
+
+    static TFW_LooperAwaiter*& Posting() {
+        thread_local TFW_LooperAwaiter* posting = nullptr;
+        return posting;
+    }
+
+    const TFW_Looper* looper_;
+    uint64_t delayMillis_;
+    int32_t status_ = TFW_ERROR;
+};
+
+/**
+ * 切换到looper线程继续执行，已在该looper上时也会重新排队
+ * Continue the coroutine on the looper thread; re-queues even when already on that looper
+ * @return co_await结果为TFW_SUCCESS，失败时协程在当前线程继续 / Status of the hop
+ */
+inline TFW_LooperAwaiter TFW_ResumeOn(const TFW_Looper* looper) {
+    return TFW_LooperAwaiter(looper, 0);
+}
+
+/**
+ * 在looper的定时器队列上等待delayMillis后于looper线程继续执行，不占用线程
+ * Sleep on the looper timer queue and continue on the looper thread
+ * @return co_await结果为TFW_SUCCESS，失败时协程在当前线程继续 / Status of the delay
+ */
+inline TFW_LooperAwaiter TFW_Delay(const TFW_Looper* looper, uint64_t delayMillis) {
+    return TFW_LooperAwaiter(looper, delayMillis);
+}
+
+// co_await TFW_Future<T>：在设置结果的线程上恢复，得到TFW_FutureResult<T>
+template <typename T>
+class TFW_FutureAwaiter {
+public:
+    explicit TFW_FutureAwaiter(TFW_Future<T>&& future) : future_(std::move(future)) {}
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    // 结果与挂起竞争一次交换，先到的一方让出，后到的一方负责继续执行
+    bool await_suspend(std::coroutine_handle<> handle) {
+        future_.OnComplete([this, handle](TFW_FutureResult<T>&& result) {
+            result_ = std::move(result);
+            if (done_.exchange(true, std::memory_order_acq_rel)) {
+                handle.resume();
+            }
+        });
+        return !done_.exchange(true, std::memory_order_acq_rel);
+    }
+
+    TFW_FutureResult<T> await_resume() {
+        return std::move(result_);
+    }
+
+private:
+    TFW_Future<T> future_;
+    TFW_FutureResult<T> result_;
+    std::atomic<bool> done_{false};
+};
+
+template <typename T>
+TFW_FutureAwaiter<T> operator co_await(TFW_Future<T>&& future) {
+    return TFW_FutureAwaiter<T>(std::move(future));
+}
+
+} // namespace TFW
+
+template <typename T, typename... Args>
+struct std::coroutine_traits<TFW::TFW_Future<T>, Args...> {
+    using promise_type = TFW::TFW_CoroutinePromise<T>;
+};
+
+#endif // __cpp_impl_coroutine
+
+#endif // TFW_COROUTINE_H
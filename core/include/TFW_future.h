@@ -0,0 +1,462 @@
+#ifndef TFW_FUTURE_H
+#define TFW_FUTURE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "TFW_errorno.h"
+#include "TFW_message_loop.h"
+#include "TFW_task.h"
+
+namespace TFW {
+
+// ============================================================================
+// Future/Promise：结果由第一个设置者写入，续体在结果就绪时执行一次，不阻塞线程
+// Future/Promise: the first setter wins; the single continuation runs once the result is ready
+// ============================================================================
+
+#define TFW_FUTURE_WAIT_FOREVER UINT64_MAX
+
+template <typename T>
+class TFW_Future;
+
+template <typename T>
+class TFW_Promise;
+
+// void结果的占位值
+struct TFW_Unit {};
+
+template <typename T>
+using TFW_FutureValue = std::conditional_t<std::is_void<T>::value, TFW_Unit, T>;
+
+// 异步结果：error为TFW_SUCCESS时value有效
+template <typename T>
+struct TFW_FutureResult {
+    int32_t error = TFW_ERROR;
+    std::optional<TFW_FutureValue<T>> value;
+
+    bool Ok() const {
+        return error == TFW_SUCCESS;
+    }
+
+    static TFW_FutureResult Error(int32_t err) {
+        TFW_FutureResult result;
+        result.error = err;
+        return result;
+    }
+
+    template <typename... Args>
+    static TFW_FutureResult Value(Args&&... args) {
+        TFW_FutureResult result;
+        result.error = TFW_SUCCESS;
+        result.value.emplace(std::forward<Args>(args)...);
+        return result;
+    }
+};
+
+// 共享状态：结果与续体各写一次，以一次CAS决定由哪一方执行续体，无锁
+template <typename T>
+class TFW_FutureState {
+public:
+    class Callback {
+    public:
+        virtual ~Callback() = default;
+        virtual void Run(TFW_FutureResult<T>&& result) = 0;
+    };
+
+    // 返回false表示结果已被其他设置者写入
+    bool SetResult(TFW_FutureResult<T>&& result) {
+        bool expected = false;
+        if (!claimed_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            return false;
+        }
+        result_ = std::move(result);
+        uint32_t phase = PHASE_EMPTY;
+        if (!phase_.compare_exchange_strong(phase, PHASE_RESULT, std::memory_order_acq_rel)) {
+            RunCallback();
+        }
+        return true;
+    }
+
+    // 只可设置一次；结果已就绪时在当前线程立即执行
+    void SetCallback(std::unique_ptr<Callback> callback) {
+        callback_ = std::move(callback);
+        uint32_t phase = PHASE_EMPTY;
+        if (!phase_.compare_exchange_strong(phase, PHASE_CALLBACK, std::memory_order_acq_rel)) {
+            RunCallback();
+        }
+    }
+
+    bool IsReady() const {
+        return phase_.load(std::memory_order_acquire) == PHASE_RESULT;
+    }
+
+private:
+    enum : uint32_t {
+        PHASE_EMPTY = 0,
+        PHASE_CALLBACK,
+        PHASE_RESULT,
+        PHASE_DONE,
+    };
+
+    void RunCallback() {
+        phase_.store(PHASE_DONE, std::memory_order_relaxed);
+        std::unique_ptr<Callback> callback = std::move(callback_);
+        callback->Run(std::move(result_));
+    }
+
+    std::atomic<bool> claimed_{false};
+    std::atomic<uint32_t> phase_{PHASE_EMPTY};
+    TFW_FutureResult<T> result_;
+    std::unique_ptr<Callback> callback_;
+};
+
+template <typename T, typename F>
+class TFW_FutureCallback : public TFW_FutureState<T>::Callback {
+public:
+    explicit TFW_FutureCallback(F&& fn) : fn_(std::move(fn)) {}
+
+    void Run(TFW_FutureResult<T>&& result) override {
+        fn_(std::move(result));
+    }
+
+private:
+    F fn_;
+};
+
+template <typename T>
+struct TFW_IsFuture : std::false_type {};
+
+template <typename T>
+struct TFW_IsFuture<TFW_Future<T>> : std::true_type {
+    using ValueType = T;
+};
+
+// 续体可接收TFW_FutureResult<T>（总是执行，可处理错误），否则接收值（出错时跳过并传递错误）
+template <typename T, typename Fn>
+struct TFW_ContinuationTraits {
+    static constexpr bool TAKES_RESULT = std::is_invocable<Fn&, TFW_FutureResult<T>&&>::value;
+
+    static auto Call(Fn& fn, TFW_FutureResult<T>& result) {
+        if constexpr (TAKES_RESULT) {
+            return fn(std::move(result));
+        } else if constexpr (std::is_void<T>::value) {
+            return fn();
+        } else {
+            return fn(std::move(*result.value));
+        }
+    }
+
+    using ReturnType = decltype(Call(std::declval<Fn&>(), std::declval<TFW_FutureResult<T>&>()));
+};
+
+template <typename R, bool IS_FUTURE = TFW_IsFuture<R>::value>
+struct TFW_UnwrapFuture {
+    using Type = R;
+};
+
+template <typename R>
+struct TFW_UnwrapFuture<R, true> {
+    using Type = typename TFW_IsFuture<R>::ValueType;
+};
+
+// Promise在设置结果前被销毁时（如承载它的消息被移除或looper销毁）以TFW_ERROR完成
+template <typename T>
+class TFW_Promise {
+public:
+    TFW_Promise() : state_(std::make_shared<TFW_FutureState<T>>()) {}
+
+    TFW_Promise(TFW_Promise&& other) noexcept = default;
+
+    TFW_Promise& operator=(TFW_Promise&& other) noexcept {
+        if (this != &other) {
+            Abandon();
+            state_ = std::move(other.state_);
+        }
+        return *this;
+    }
+
+    TFW_Promise(const TFW_Promise&) = delete;
+    TFW_Promise& operator=(const TFW_Promise&) = delete;
+
+    ~TFW_Promise() {
+        Abandon();
+    }
+
+    // 只可调用一次
+    TFW_Future<T> GetFuture() {
+        return TFW_Future<T>(state_);
+    }
+
+    // void结果不带参数
+    template <typename... Args>
+    bool SetValue(Args&&... args) {
+        return SetResult(TFW_FutureResult<T>::Value(std::forward<Args>(args)...));
+    }
+
+    bool SetError(int32_t error) {
+        return SetResult(TFW_FutureResult<T>::Error(error));
+    }
+
+    bool SetResult(TFW_FutureResult<T>&& result) {
+        return (state_ != nullptr) && state_->SetResult(std::move(result));
+    }
+
+private:
+    void Abandon() {
+        if (state_ != nullptr) {
+            (void)state_->SetResult(TFW_FutureResult<T>::Error(TFW_ERROR));
+            state_.reset();
+        }
+    }
+
+    std::shared_ptr<TFW_FutureState<T>> state_;
+};
+
+// 单消费者：Then、OnComplete、WithTimeout、Wait会取走状态，之后Valid()返回false
+template <typename T>
+class TFW_Future {
+public:
+    using ValueType = T;
+
+    TFW_Future() = default;
+    explicit TFW_Future(std::shared_ptr<TFW_FutureState<T>> state) : state_(std::move(state)) {}
+    TFW_Future(TFW_Future&&) noexcept = default;
+    TFW_Future& operator=(TFW_Future&&) noexcept = default;
+    TFW_Future(const TFW_Future&) = delete;
+    TFW_Future& operator=(const TFW_Future&) = delete;
+
+    bool Valid() const {
+        return state_ != nullptr;
+    }
+
+    bool IsReady() const {
+        return state_ != nullptr && state_->IsReady();
+    }
+
+    // 结果就绪时在设置结果的线程上执行fn(TFW_FutureResult<T>&&)
+    template <typename F>
+    void OnComplete(F&& fn) {
+        using Fn = std::decay_t<F>;
+        std::shared_ptr<TFW_FutureState<T>> state = std::move(state_);
+        if (state == nullptr) {
+            Fn callback(std::forward<F>(fn));
+            callback(TFW_FutureResult<T>::Error(TFW_ERROR_INVALID_PARAM));
+            return;
+        }
+        state->SetCallback(std::make_unique<TFW_FutureCallback<T, Fn>>(Fn(std::forward<F>(fn))));
+    }
+
+    /**
+     * 结果就绪后在looper上执行续体，looper为NULL时在设置结果的线程上直接执行；
+     * 续体返回TFW_Future<U>时展开为TFW_Future<U>
+     * Run a continuation on a looper once the result is ready; returned futures are flattened
+     * @param looper 执行续体的looper，须在结果就绪前保持存活 / Looper to run on, must outlive the result
+     * @param fn 续体，接收值或TFW_FutureResult<T> / Continuation taking the value or the full result
+     * @return 续体结果的Future，投递失败或消息未执行即被释放时以错误完成 / Future of the continuation result
+     */
+    template <typename F>
+    auto Then(const TFW_Looper* looper, F&& fn) {
+        using Fn = std::decay_t<F>;
+        using Traits = TFW_ContinuationTraits<T, Fn>;
+        using R = typename Traits::ReturnType;
+        using D = typename TFW_UnwrapFuture<R>::Type;
+
+        TFW_Promise<D> promise;
+        TFW_Future<D> next = promise.GetFuture();
+        OnComplete([looper, fn = Fn(std::forward<F>(fn)), promise = std::move(promise)]
+            (TFW_FutureResult<T>&& result) mutable {
+            if (looper == nullptr) {
+                RunContinuation(fn, promise, result);
+                return;
+            }
+            (void)TFW_PostTask(looper, [fn = std::move(fn), promise = std::move(promise),
+                result = std::move(result)]() mutable {
+                RunContinuation(fn, promise, result);
+            });
+        });
+        return next;
+    }
+
+    // timeoutMs内未就绪时以TFW_ERROR_TIMEOUT完成；计时使用looper的定时堆，结果先就绪时取消计时消息
+    TFW_Future<T> WithTimeout(const TFW_Looper* looper, uint64_t timeoutMs) {
+        auto state = std::make_shared<TFW_FutureState<T>>();
+        TFW_MessageHandle timer = TFW_MESSAGE_HANDLE_INVALID;
+        int32_t ret = TFW_PostTask(looper, [state]() {
+            (void)state->SetResult(TFW_FutureResult<T>::Error(TFW_ERROR_TIMEOUT));
+        }, timeoutMs, &timer);
+        if (ret != TFW_SUCCESS) {
+            (void)state->SetResult(TFW_FutureResult<T>::Error(ret));
+        }
+        OnComplete([state, looper, timer](TFW_FutureResult<T>&& result) {
+            if (state->SetResult(std::move(result)) && timer != TFW_MESSAGE_HANDLE_INVALID) {
+                (void)TFW_LooperCancel(looper, timer);
+            }
+        });
+        return TFW_Future<T>(state);
+    }
+
+    // 阻塞等待结果，仅用于同步边界；不可在产生该结果的looper线程上调用
+    int32_t Wait(uint64_t timeoutMs = TFW_FUTURE_WAIT_FOREVER, TFW_FutureValue<T>* value = nullptr) {
+        struct Waiter {
+            std::mutex lock;
+            std::condition_variable cond;
+            bool done = false;
+            TFW_FutureResult<T> result;
+        };
+        auto waiter = std::make_shared<Waiter>();
+        OnComplete([waiter](TFW_FutureResult<T>&& result) {
+            std::lock_guard<std::mutex> guard(waiter->lock);
+            waiter->result = std::move(result);
+            waiter->done = true;
+            waiter->cond.notify_all();
+        });
+        std::unique_lock<std::mutex> guard(waiter->lock);
+        if (timeoutMs == TFW_FUTURE_WAIT_FOREVER) {
+            waiter->cond.wait(guard, [&waiter]() { return waiter->done; });
+        } else if (!waiter->cond.wait_for(guard, std::chrono::milliseconds(timeoutMs),
+            [&waiter]() { return waiter->done; })) {
+            return TFW_ERROR_TIMEOUT;
+        }
+        if (waiter->result.Ok() && value != nullptr) {
+            *value = std::move(*waiter->result.value);
+        }
+        return waiter->result.error;
+    }
+
+private:
+    template <typename Fn, typename D>
+    static void RunContinuation(Fn& fn, TFW_Promise<D>& promise, TFW_FutureResult<T>& result) {
+        using Traits = TFW_ContinuationTraits<T, Fn>;
+        using R = typename Traits::ReturnType;
+        if constexpr (!Traits::TAKES_RESULT) {
+            if (!result.Ok()) {
+                promise.SetError(result.error);
+                return;
+            }
+        }
+        if constexpr (TFW_IsFuture<R>::value) {
+            R inner = Traits::Call(fn, result);
+            inner.OnComplete([promise = std::move(promise)](TFW_FutureResult<D>&& innerResult) mutable {
+                promise.SetResult(std::move(innerResult));
+            });
+        } else if constexpr (std::is_void<R>::value) {
+            Traits::Call(fn, result);
+            promise.SetValue();
+        } else {
+            promise.SetValue(Traits::Call(fn, result));
+        }
+    }
+
+    std::shared_ptr<TFW_FutureState<T>> state_;
+};
+
+template <typename T, typename... Args>
+TFW_Future<T> TFW_MakeReadyFuture(Args&&... args) {
+    TFW_Promise<T> promise;
+    TFW_Future<T> future = promise.GetFuture();
+    promise.SetValue(std::forward<Args>(args)...);
+    return future;
+}
+
+template <typename T>
+TFW_Future<T> TFW_MakeErrorFuture(int32_t error) {
+    TFW_Promise<T> promise;
+    TFW_Future<T> future = promise.GetFuture();
+    promise.SetError(error);
+    return future;
+}
+
+// 全部成功时按输入顺序给出结果；任一失败时立即以该错误完成
+template <typename T>
+TFW_Future<std::vector<TFW_FutureValue<T>>> TFW_WhenAll(std::vector<TFW_Future<T>> futures) {
+    using V = TFW_FutureValue<T>;
+    struct Context {
+        std::vector<std::optional<V>> values;
+        std::atomic<size_t> remaining;
+    };
+    auto state = std::make_shared<TFW_FutureState<std::vector<V>>>();
+    if (futures.empty()) {
+        (void)state->SetResult(TFW_FutureResult<std::vector<V>>::Value());
+        return TFW_Future<std::vector<V>>(state);
+    }
+    auto context = std::make_shared<Context>();
+    context->values.resize(futures.size());
+    context->remaining.store(futures.size(), std::memory_order_relaxed);
+    for (size_t i = 0; i < futures.size(); i++) {
+        futures[i].OnComplete([state, context, i](TFW_FutureResult<T>&& result) {
+            if (!result.Ok()) {
+                (void)state->SetResult(TFW_FutureResult<std::vector<V>>::Error(result.error));
+                return;
+            }
+            context->values[i] = std::move(result.value);
+            if (context->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+            std::vector<V> values;
+            values.reserve(context->values.size());
+            for (std::optional<V>& value : context->values) {
+                values.push_back(std::move(*value));
+            }
+            (void)state->SetResult(TFW_FutureResult<std::vector<V>>::Value(std::move(values)));
+        });
+    }
+    return TFW_Future<std::vector<V>>(state);
+}
+
+// 第一个成功的结果及其下标；全部失败时以最后一个错误完成
+template <typename T>
+TFW_Future<std::pair<size_t, TFW_FutureValue<T>>> TFW_WhenAny(std::vector<TFW_Future<T>> futures) {
+    using P = std::pair<size_t, TFW_FutureValue<T>>;
+    auto state = std::make_shared<TFW_FutureState<P>>();
+    if (futures.empty()) {
+        (void)state->SetResult(TFW_FutureResult<P>::Error(TFW_ERROR_INVALID_PARAM));
+        return TFW_Future<P>(state);
+    }
+    auto failed = std::make_shared<std::atomic<size_t>>(0);
+    size_t total = futures.size();
+    for (size_t i = 0; i < total; i++) {
+        futures[i].OnComplete([state, failed, total, i](TFW_FutureResult<T>&& result) {
+            if (result.Ok()) {
+                (void)state->SetResult(TFW_FutureResult<P>::Value(i, std::move(*result.value)));
+            } else if (failed->fetch_add(1, std::memory_order_acq_rel) + 1 == total) {
+                (void)state->SetResult(TFW_FutureResult<P>::Error(result.error));
+            }
+        });
+    }
+    return TFW_Future<P>(state);
+}
+
+/**
+ * 在looper上执行fn并以其返回值完成Future
+ * Run fn on a looper and complete the future with its return value
+ * @return fn结果的Future，投递失败或消息未执行即被释放时以TFW_ERROR完成 / Future of fn's result
+ */
+template <typename F>
+auto TFW_PostAsync(const TFW_Looper* looper, F&& fn, uint64_t delayMillis = 0) {
+    using Fn = std::decay_t<F>;
+    using R = std::invoke_result_t<Fn&>;
+    TFW_Promise<R> promise;
+    TFW_Future<R> future = promise.GetFuture();
+    (void)TFW_PostTask(looper, [fn = Fn(std::forward<F>(fn)), promise = std::move(promise)]() mutable {
+        if constexpr (std::is_void<R>::value) {
+            fn();
+            promise.SetValue();
+        } else {
+            promise.SetValue(fn());
+        }
+    }, delayMillis);
+    return future;
+}
+
+} // namespace TFW
+
+#endif // TFW_FUTURE_H
@@ -4,33 +4,27 @@
 #include "TFW_types.h"
 #include "TFW_single_instance.h"
 #include "TFW_message_loop.h"
+#include "TFW_future.h"
+#include "TFW_task.h"
 
 namespace TFW {
 
 // 定义回调函数类型
 typedef void (*TFW_AsyncCallbackFunc)(void* para);
 
-// 回调信息结构体
-typedef struct {
-    TFW_Message* msg;
-    TFW_Handler handler;
-    TFW_AsyncCallbackFunc callback;
-    void* cbPara;
-} TFW_AsyncCallbackInfo;
-
 class TFW_MsgLoopMgr {
     TFW_DECLARE_SINGLE_INSTANCE(TFW_MsgLoopMgr)
 
 private:
     // 内部状态
     bool isInitialized_ = false;
-    TFW_Handler asyncCallbackHandler_;  // 成员变量，避免重复初始化
+    // PostAsyncCallback投递的闭包统计标签
+    TFW_Handler asyncCallbackHandler_ = {};
 
-    // 私有方法用于处理异步回调消息
-    static void AsyncCallbackHandler(TFW_Message* msg);
-    static void FreeAsyncCallbackMessage(TFW_Message* msg);
-    static void InitAsyncCallbackMessage(TFW_Message* msg, int32_t what, void* obj, TFW_Handler* handler);
-    TFW_AsyncCallbackInfo* CreateAsyncCallbackInfo(TFW_Looper* looper, TFW_AsyncCallbackFunc callback, void* para);
+    // 闭包消息已构造，以下方法负责查找looper并投递，失败时释放消息
+    int32_t PostTaskMessage(TFW_LooperType type, TFW_Message* msg, uint64_t delayMillis,
+        TFW_MessageHandle* handle);
+    int32_t PostTaskMessage(const char* name, TFW_Message* msg, uint64_t delayMillis, TFW_MessageHandle* handle);
 
 public:
     // 初始化和去初始化
@@ -41,9 +35,75 @@ public:
     // 获取指定类型的消息循环（保留原有接口，但建议使用下面的封装方法）
     TFW_Looper* GetLooper(TFW_LooperType type);
 
-    // 简化的异步回调接口
-    int32_t PostAsyncCallback(TFW_LooperType type = TFW_LOOP_TYPE_DEFAULT, TFW_AsyncCallbackFunc callback = nullptr, void* para = nullptr);
-    int32_t PostAsyncCallbackDelay(TFW_LooperType type = TFW_LOOP_TYPE_DEFAULT, TFW_AsyncCallbackFunc callback = nullptr, void* para = nullptr, uint64_t delayMillis = 0);
+    // 按名称获取looper并增加引用计数，不存在时以attr创建；子系统可持有独立的looper
+    TFW_Looper* AcquireLooper(const char* name, const TFW_LooperAttr* attr = nullptr);
+
+    // 释放AcquireLooper获得的引用，最后一个引用释放时销毁looper
+    void ReleaseLooper(TFW_Looper* looper);
+
+    // 获取并发looper使用的工作窃取执行器，可直接提交不需要顺序保证的任务
+    TFW_Executor* GetExecutor();
+
+    // 获取指定类型消息循环的运行时统计
+    int32_t GetLooperStats(TFW_LooperType type, TFW_LooperStats* stats);
+
+    // 简化的异步回调接口；handler为调用者的统计标签(见TFW_TaskHandlerInit)，为nullptr时按TFW_AsyncHandler汇总
+    int32_t PostAsyncCallback(TFW_LooperType type = TFW_LOOP_TYPE_DEFAULT, TFW_AsyncCallbackFunc callback = nullptr, void* para = nullptr,
+        const TFW_Handler* handler = nullptr);
+    int32_t PostAsyncCallbackDelay(TFW_LooperType type = TFW_LOOP_TYPE_DEFAULT, TFW_AsyncCallbackFunc callback = nullptr, void* para = nullptr, uint64_t delayMillis = 0,
+        const TFW_Handler* handler = nullptr);
+
+    // 投递到已注册的命名looper，looper不存在时返回TFW_ERROR_NOT_FOUND
+    int32_t PostAsyncCallback(const char* name, TFW_AsyncCallbackFunc callback, void* para,
+        const TFW_Handler* handler = nullptr);
+    int32_t PostAsyncCallbackDelay(const char* name, TFW_AsyncCallbackFunc callback, void* para, uint64_t delayMillis,
+        const TFW_Handler* handler = nullptr);
+
+    // 投递任意可调用对象，捕获不超过TFW_MESSAGE_INLINE_SIZE时存放在池化消息内，不额外分配；
+    // handle非空时返回可用于TFW_LooperCancel的句柄，handler为可选的统计标签(见TFW_TaskHandlerInit)
+    template <typename F>
+    int32_t PostTask(TFW_LooperType type, F&& task, uint64_t delayMillis = 0, TFW_MessageHandle* handle = nullptr,
+        const TFW_Handler* handler = nullptr) {
+        TFW_Message* msg = TFW_MakeTaskMessage(std::forward<F>(task), handler);
+        if (msg == nullptr) {
+            return TFW_ERROR_MALLOC_ERR;
+        }
+        return PostTaskMessage(type, msg, delayMillis, handle);
+    }
+
+    // 投递到已注册的命名looper，looper不存在时返回TFW_ERROR_NOT_FOUND
+    template <typename F>
+    int32_t PostTask(const char* name, F&& task, uint64_t delayMillis = 0, TFW_MessageHandle* handle = nullptr,
+        const TFW_Handler* handler = nullptr) {
+        TFW_Message* msg = TFW_MakeTaskMessage(std::forward<F>(task), handler);
+        if (msg == nullptr) {
+            return TFW_ERROR_MALLOC_ERR;
+        }
+        return PostTaskMessage(name, msg, delayMillis, handle);
+    }
+
+    // 在looper上执行fn，返回以其返回值完成的Future，可继续Then/WhenAll/WithTimeout组合
+    template <typename F>
+    auto PostAsync(TFW_LooperType type, F&& fn, uint64_t delayMillis = 0) {
+        using R = std::invoke_result_t<std::decay_t<F>&>;
+        TFW_Looper* looper = GetLooper(type);
+        if (looper == nullptr) {
+            return TFW_MakeErrorFuture<R>(TFW_ERROR);
+        }
+        return TFW_PostAsync(looper, std::forward<F>(fn), delayMillis);
+    }
+
+    template <typename F>
+    auto PostAsync(const char* name, F&& fn, uint64_t delayMillis = 0) {
+        using R = std::invoke_result_t<std::decay_t<F>&>;
+        TFW_Looper* looper = IsInitialized() ? TFW_LooperFind(name) : nullptr;
+        if (looper == nullptr) {
+            return TFW_MakeErrorFuture<R>(TFW_ERROR_NOT_FOUND);
+        }
+        TFW_Future<R> future = TFW_PostAsync(looper, std::forward<F>(fn), delayMillis);
+        TFW_LooperRelease(looper);
+        return future;
+    }
 };
 
 } // namespace TFW
@@ -0,0 +1,148 @@
+#ifndef TFW_TASK_H
+#define TFW_TASK_H
+
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "TFW_errorno.h"
+#include "TFW_looper_group.h"
+#include "TFW_message_loop.h"
+#include "TFW_strand.h"
+
+namespace TFW {
+
+// 闭包消息的操作表，每种可调用对象类型一份，由消息的obj指向
+typedef struct {
+    void (*invoke)(TFW_Message* msg);
+    void (*destroy)(TFW_Message* msg);
+} TFW_TaskOps;
+
+// 可调用对象不超过消息内联数据区且对齐满足时原地构造，否则单独分配并在内联数据区保存指针
+template <typename Fn>
+constexpr bool TFW_TaskFitsInline = sizeof(Fn) <= TFW_MESSAGE_INLINE_SIZE &&
+    alignof(Fn) <= alignof(TFW_MessageInline);
+
+template <typename Fn>
+struct TFW_TaskTraits {
+    static Fn* Get(TFW_Message* msg) {
+        if constexpr (TFW_TaskFitsInline<Fn>) {
+            return std::launder(reinterpret_cast<Fn*>(msg->inlineData.bytes));
+        } else {
+            return *reinterpret_cast<Fn**>(msg->inlineData.bytes);
+        }
+    }
+
+    static void Invoke(TFW_Message* msg) {
+        (*Get(msg))();
+    }
+
+    static void Destroy(TFW_Message* msg) {
+        if constexpr (TFW_TaskFitsInline<Fn>) {
+            Get(msg)->~Fn();
+        } else {
+            delete Get(msg);
+        }
+    }
+
+    static constexpr TFW_TaskOps ops = { Invoke, Destroy };
+};
+
+/**
+ * 初始化闭包消息的handler标签。投递时传入后统计按其name汇总，并可通过RemoveMessage(looper, handler, 0)
+ * 移除该标签下尚未执行的任务；handler须在其消息全部执行或释放前保持有效，通常为静态或成员对象
+ * Init a task handler tag; tasks posted with it report under its name in looper stats
+ * @param handler 标签handler / Tag handler
+ * @param name 统计名称，须在handler有效期内保持有效 / Stats name, must outlive the handler
+ */
+void TFW_TaskHandlerInit(TFW_Handler* handler, const char* name);
+
+// 设置任务handler与释放函数，looper执行后析构可调用对象并将消息归还消息池；
+// handler为nullptr或不是TFW_TaskHandlerInit初始化的标签时使用共享的TFW_Task handler
+void TFW_TaskMessageInit(TFW_Message* msg, const TFW_TaskOps* ops, const TFW_Handler* handler = nullptr);
+
+// 投递闭包消息，失败时消息已释放；handle非空时返回取消句柄
+int32_t TFW_PostTaskMessage(const TFW_Looper* looper, TFW_Message* msg, uint64_t delayMillis,
+    TFW_MessageHandle* handle);
+
+// 投递闭包消息到strand，失败时消息已释放
+int32_t TFW_PostTaskMessage(TFW_Strand* strand, TFW_Message* msg, uint64_t delayMillis);
+
+// 按键哈希投递闭包消息到looper组，失败时消息已释放
+int32_t TFW_PostTaskMessage(TFW_LooperGroup* group, uint64_t keyHash, TFW_Message* msg, uint64_t delayMillis);
+
+// 从消息池分配消息并将可调用对象移入，handler为可选的统计标签，分配失败返回nullptr
+template <typename F>
+TFW_Message* TFW_MakeTaskMessage(F&& task, const TFW_Handler* handler = nullptr) {
+    using Fn = std::decay_t<F>;
+    TFW_Message* msg = TFW_MallocMessage();
+    if (msg == nullptr) {
+        return nullptr;
+    }
+    if constexpr (TFW_TaskFitsInline<Fn>) {
+        ::new (static_cast<void*>(msg->inlineData.bytes)) Fn(std::forward<F>(task));
+    } else {
+        Fn* heap = new (std::nothrow) Fn(std::forward<F>(task));
+        if (heap == nullptr) {
+            TFW_FreeMessage(msg);
+            return nullptr;
+        }
+        *reinterpret_cast<Fn**>(msg->inlineData.bytes) = heap;
+    }
+    TFW_TaskMessageInit(msg, &TFW_TaskTraits<Fn>::ops, handler);
+    return msg;
+}
+
+/**
+ * 向looper投递任意可调用对象，捕获不超过TFW_MESSAGE_INLINE_SIZE时只占用一条池化消息，不额外分配
+ * Post any callable to a looper; small captures are stored inline in the pooled message
+ * @param looper 目标looper / Target looper
+ * @param task 可调用对象，在looper线程上以task()调用 / Callable invoked as task() on the looper
+ * @param delayMillis 延迟毫秒数，0走即时投递路径 / Delay in milliseconds, 0 uses the immediate path
+ * @param handle 非空时返回可用于TFW_LooperCancel的句柄 / Optional cancellation handle
+ * @param handler 可选的统计标签，见TFW_TaskHandlerInit / Optional stats tag, see TFW_TaskHandlerInit
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+template <typename F>
+int32_t TFW_PostTask(const TFW_Looper* looper, F&& task, uint64_t delayMillis = 0,
+    TFW_MessageHandle* handle = nullptr, const TFW_Handler* handler = nullptr) {
+    TFW_Message* msg = TFW_MakeTaskMessage(std::forward<F>(task), handler);
+    if (msg == nullptr) {
+        return TFW_ERROR_MALLOC_ERR;
+    }
+    return TFW_PostTaskMessage(looper, msg, delayMillis, handle);
+}
+
+/**
+ * 向strand投递任意可调用对象，同一strand上的任务按投递顺序逐条执行
+ * Post any callable to a strand; tasks on one strand run one at a time in post order
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+template <typename F>
+int32_t TFW_PostTask(TFW_Strand* strand, F&& task, uint64_t delayMillis = 0, const TFW_Handler* handler = nullptr) {
+    TFW_Message* msg = TFW_MakeTaskMessage(std::forward<F>(task), handler);
+    if (msg == nullptr) {
+        return TFW_ERROR_MALLOC_ERR;
+    }
+    return TFW_PostTaskMessage(strand, msg, delayMillis);
+}
+
+/**
+ * 按键哈希向looper组投递任意可调用对象，相同keyHash的任务按投递顺序执行
+ * Post any callable to a looper group; tasks with the same key hash run in post order
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+template <typename F>
+int32_t TFW_PostTask(TFW_LooperGroup* group, uint64_t keyHash, F&& task, uint64_t delayMillis = 0,
+    const TFW_Handler* handler = nullptr) {
+    TFW_Message* msg = TFW_MakeTaskMessage(std::forward<F>(task), handler);
+    if (msg == nullptr) {
+        return TFW_ERROR_MALLOC_ERR;
+    }
+    return TFW_PostTaskMessage(group, keyHash, msg, delayMillis);
+}
+
+} // namespace TFW
+
+#endif // TFW_TASK_H
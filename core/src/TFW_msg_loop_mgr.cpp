@@ -11,7 +11,6 @@ namespace TFW {
 TFW_IMPLEMENT_SINGLE_INSTANCE(TFW_MsgLoopMgr)
 
 #define TFW_ASYNC_CALLBACK_HANDLER_NAME "TFW_AsyncHandler"
-#define TFW_ASYNC_CALLBACK_MSG_TYPE 0
 
 int32_t TFW_MsgLoopMgr::Init() {
     TFW_LOGI_CORE("TFW_MsgLoopMgr::Init called");
@@ -28,10 +27,8 @@ int32_t TFW_MsgLoopMgr::Init() {
         return TFW_ERROR;
     }
 
-    // 初始化异步回调处理器
-    asyncCallbackHandler_.name = const_cast<char*>(TFW_ASYNC_CALLBACK_HANDLER_NAME);
-    asyncCallbackHandler_.looper = nullptr;
-    asyncCallbackHandler_.HandleMessage = AsyncCallbackHandler;
+    // 异步回调在统计中按TFW_AsyncHandler汇总，与其他闭包任务区分
+    TFW_TaskHandlerInit(&asyncCallbackHandler_, TFW_ASYNC_CALLBACK_HANDLER_NAME);
 
     // 设置初始化标志
     isInitialized_ = true;
@@ -48,9 +45,6 @@ int32_t TFW_MsgLoopMgr::Deinit() {
         return TFW_SUCCESS;
     }
 
-    asyncCallbackHandler_.looper = nullptr;
-    asyncCallbackHandler_.HandleMessage = nullptr;
-
     // 清理资源
     TFW_LooperDeinit();
     TFW_LOGI_CORE("Message loop module deinitialized");
@@ -81,157 +75,119 @@ TFW_Looper* TFW_MsgLoopMgr::GetLooper(TFW_LooperType type) {
     return looper;
 }
 
-// 异步回调处理函数
-void TFW_MsgLoopMgr::AsyncCallbackHandler(TFW_Message* msg) {
-    TFW_AsyncCallbackInfo* info = nullptr;
-
-    if (msg == nullptr) {
-        TFW_LOGE_CORE("Async callback received null message");
-        return;
-    }
-
-    info = (TFW_AsyncCallbackInfo*)msg->obj;
-    if (info == nullptr) {
-        TFW_LOGE_CORE("Async callback received null info");
-        return;
-    }
-
-    if (info->callback == nullptr) {
-        TFW_LOGE_CORE("Async callback function is null");
-        return;
+TFW_Executor* TFW_MsgLoopMgr::GetExecutor() {
+    if (!IsInitialized()) {
+        TFW_LOGE_CORE("Msg loop manager not initialized");
+        return nullptr;
     }
 
-    // 执行回调函数
-    info->callback(info->cbPara);
+    return TFW_GetDefaultExecutor();
 }
 
-// 释放异步回调消息
-void TFW_MsgLoopMgr::FreeAsyncCallbackMessage(TFW_Message* msg) {
-    TFW_AsyncCallbackInfo* info = nullptr;
-
-    if (msg == nullptr || msg->obj == nullptr) {
-        TFW_LOGE_CORE("Failed: message or callback is null");
-        return;
+int32_t TFW_MsgLoopMgr::GetLooperStats(TFW_LooperType type, TFW_LooperStats* stats) {
+    if (!IsInitialized()) {
+        TFW_LOGE_CORE("Msg loop manager not initialized");
+        return TFW_ERROR_NOT_INIT;
     }
 
-    info = (TFW_AsyncCallbackInfo*)msg->obj;
-    TFW_Free(info);
-}
+    TFW_Looper* looper = TFW_GetLooper(type);
+    if (looper == nullptr) {
+        TFW_LOGE_CORE("Failed to get looper for type: %d", type);
+        return TFW_ERROR;
+    }
 
-// 初始化异步回调消息
-void TFW_MsgLoopMgr::InitAsyncCallbackMessage(TFW_Message* msg, int32_t what, void* obj, TFW_Handler* handler) {
-    msg->what = what;
-    msg->obj = obj;
-    msg->handler = handler;
-    msg->FreeMessage = FreeAsyncCallbackMessage;
-    msg->arg1 = 0;
-    msg->arg2 = 0;
-    msg->time = 0;
+    return TFW_LooperGetStats(looper, stats);
 }
 
-// 创建异步回调信息
-TFW_AsyncCallbackInfo* TFW_MsgLoopMgr::CreateAsyncCallbackInfo(TFW_Looper* looper,
-    TFW_AsyncCallbackFunc callback, void* para) {
-    TFW_AsyncCallbackInfo* info = nullptr;
-
-    info = (TFW_AsyncCallbackInfo*)TFW_Calloc(sizeof(TFW_AsyncCallbackInfo));
-    if (info == nullptr) {
-        TFW_LOGE_CORE("Failed to allocate memory for async callback info");
-        return nullptr;
-    }
-    TFW_Message* msg = (TFW_Message*)TFW_Calloc(sizeof(TFW_Message));
-    if (msg == nullptr) {
-        TFW_LOGE_CORE("Failed to allocate memory for async callback message");
-        TFW_Free(info);
+TFW_Looper* TFW_MsgLoopMgr::AcquireLooper(const char* name, const TFW_LooperAttr* attr) {
+    if (!IsInitialized()) {
+        TFW_LOGE_CORE("Msg loop manager not initialized");
         return nullptr;
     }
-    info->msg = msg;
-    info->callback = callback;
-    info->cbPara = para;
-    info->handler = asyncCallbackHandler_;
-    info->handler.looper = looper;
-    InitAsyncCallbackMessage(info->msg, TFW_ASYNC_CALLBACK_MSG_TYPE, (void*)info, &info->handler);
 
-    return info;
+    TFW_Looper* looper = TFW_LooperAcquire(name, attr);
+    if (looper == nullptr) {
+        TFW_LOGE_CORE("Failed to acquire looper: %s", (name != nullptr) ? name : "null");
+    }
+    return looper;
 }
 
-// 异步回调辅助函数
-int32_t TFW_MsgLoopMgr::PostAsyncCallback(TFW_LooperType type, TFW_AsyncCallbackFunc callback, void* para) {
-    TFW_AsyncCallbackInfo* info = nullptr;
-    TFW_Looper* looper = nullptr;
+void TFW_MsgLoopMgr::ReleaseLooper(TFW_Looper* looper) {
+    TFW_LooperRelease(looper);
+}
 
+// 闭包消息投递，失败时释放消息
+int32_t TFW_MsgLoopMgr::PostTaskMessage(TFW_LooperType type, TFW_Message* msg, uint64_t delayMillis,
+    TFW_MessageHandle* handle) {
     if (!IsInitialized()) {
         TFW_LOGE_CORE("Msg loop manager not initialized");
+        TFW_FreeMessage(msg);
         return TFW_ERROR_NOT_INIT;
     }
 
-    if (callback == nullptr) {
-        TFW_LOGE_CORE("Callback function is null");
-        return TFW_ERROR_INVALID_PARAM;
-    }
-
-    looper = TFW_GetLooper(type);
+    TFW_Looper* looper = TFW_GetLooper(type);
     if (looper == nullptr) {
         TFW_LOGE_CORE("Failed to get looper for type: %d", type);
+        TFW_FreeMessage(msg);
         return TFW_ERROR;
     }
 
-    info = CreateAsyncCallbackInfo(looper, callback, para);
-    if (info == nullptr) {
-        TFW_LOGE_CORE("Failed to create async callback info");
-        return TFW_ERROR_MALLOC_ERR;
-    }
-
-    // 直接通过looper发送消息
-    if (looper->PostMessage != nullptr) {
-        looper->PostMessage(looper, info->msg);
-    } else {
-        TFW_LOGE_CORE("PostMessage function pointer is null for looper type: %d", type);
-        TFW_Free(info);
-        return TFW_ERROR;
-    }
-
-    return TFW_SUCCESS;
+    return TFW_PostTaskMessage(looper, msg, delayMillis, handle);
 }
 
-// 延迟异步回调辅助函数
-int32_t TFW_MsgLoopMgr::PostAsyncCallbackDelay(TFW_LooperType type, TFW_AsyncCallbackFunc callback,
-    void* para, uint64_t delayMillis) {
-    TFW_AsyncCallbackInfo* info = nullptr;
-    TFW_Looper* looper = nullptr;
-
+int32_t TFW_MsgLoopMgr::PostTaskMessage(const char* name, TFW_Message* msg, uint64_t delayMillis,
+    TFW_MessageHandle* handle) {
     if (!IsInitialized()) {
         TFW_LOGE_CORE("Msg loop manager not initialized");
+        TFW_FreeMessage(msg);
         return TFW_ERROR_NOT_INIT;
     }
 
+    // 持有引用期间looper不会被销毁
+    TFW_Looper* looper = TFW_LooperFind(name);
+    if (looper == nullptr) {
+        TFW_LOGE_CORE("Failed to find looper: %s", (name != nullptr) ? name : "null");
+        TFW_FreeMessage(msg);
+        return TFW_ERROR_NOT_FOUND;
+    }
+
+    int32_t ret = TFW_PostTaskMessage(looper, msg, delayMillis, handle);
+    TFW_LooperRelease(looper);
+    return ret;
+}
+
+// 异步回调辅助函数
+int32_t TFW_MsgLoopMgr::PostAsyncCallback(TFW_LooperType type, TFW_AsyncCallbackFunc callback, void* para,
+    const TFW_Handler* handler) {
+    return PostAsyncCallbackDelay(type, callback, para, 0, handler);
+}
+
+// 延迟异步回调辅助函数，回调与参数作为闭包存放在消息内联数据区
+int32_t TFW_MsgLoopMgr::PostAsyncCallbackDelay(TFW_LooperType type, TFW_AsyncCallbackFunc callback,
+    void* para, uint64_t delayMillis, const TFW_Handler* handler) {
     if (callback == nullptr) {
         TFW_LOGE_CORE("Callback function is null");
         return TFW_ERROR_INVALID_PARAM;
     }
 
-    looper = TFW_GetLooper(type);
-    if (looper == nullptr) {
-        TFW_LOGE_CORE("Failed to get looper for type: %d", type);
-        return TFW_ERROR;
-    }
+    return PostTask(type, [callback, para]() { callback(para); }, delayMillis, nullptr,
+        (handler != nullptr) ? handler : &asyncCallbackHandler_);
+}
 
-    info = CreateAsyncCallbackInfo(looper, callback, para);
-    if (info == nullptr) {
-        TFW_LOGE_CORE("Failed to create async callback info");
-        return TFW_ERROR_MALLOC_ERR;
-    }
+int32_t TFW_MsgLoopMgr::PostAsyncCallback(const char* name, TFW_AsyncCallbackFunc callback, void* para,
+    const TFW_Handler* handler) {
+    return PostAsyncCallbackDelay(name, callback, para, 0, handler);
+}
 
-    // 通过looper发送延迟消息
-    if (looper->PostMessageDelay != nullptr) {
-        looper->PostMessageDelay(looper, info->msg, delayMillis);
-    } else {
-        TFW_LOGE_CORE("PostMessageDelay function pointer is null for looper type: %d", type);
-        TFW_Free(info);
-        return TFW_ERROR;
+int32_t TFW_MsgLoopMgr::PostAsyncCallbackDelay(const char* name, TFW_AsyncCallbackFunc callback,
+    void* para, uint64_t delayMillis, const TFW_Handler* handler) {
+    if (callback == nullptr) {
+        TFW_LOGE_CORE("Callback function is null");
+        return TFW_ERROR_INVALID_PARAM;
     }
 
-    return TFW_SUCCESS;
+    return PostTask(name, [callback, para]() { callback(para); }, delayMillis, nullptr,
+        (handler != nullptr) ? handler : &asyncCallbackHandler_);
 }
 
 } // namespace TFW
@@ -0,0 +1,80 @@
+#include "TFW_task.h"
+#include "TFW_core_log.h"
+
+namespace TFW {
+
+#define TFW_TASK_HANDLER_NAME "TFW_Task"
+
+static void TaskHandleMessage(TFW_Message* msg) {
+    static_cast<const TFW_TaskOps*>(msg->obj)->invoke(msg);
+}
+
+// 析构可调用对象后消息归还消息池
+static void TaskFreeMessage(TFW_Message* msg) {
+    static_cast<const TFW_TaskOps*>(msg->obj)->destroy(msg);
+    msg->FreeMessage = nullptr;
+    TFW_FreeMessage(msg);
+}
+
+// 未指定标签的闭包消息共享同一个handler，统计中按TFW_Task汇总
+static TFW_Handler g_taskHandler = { const_cast<char*>(TFW_TASK_HANDLER_NAME), nullptr, TaskHandleMessage };
+
+void TFW_TaskHandlerInit(TFW_Handler* handler, const char* name) {
+    if (handler == nullptr) {
+        return;
+    }
+    handler->name = const_cast<char*>((name != nullptr) ? name : TFW_TASK_HANDLER_NAME);
+    handler->looper = nullptr;
+    handler->HandleMessage = TaskHandleMessage;
+}
+
+void TFW_TaskMessageInit(TFW_Message* msg, const TFW_TaskOps* ops, const TFW_Handler* handler) {
+    // 标签的HandleMessage必须是闭包分发函数，否则looper会以普通消息处理闭包
+    if (handler == nullptr || handler->HandleMessage != TaskHandleMessage) {
+        handler = &g_taskHandler;
+    }
+    msg->what = 0;
+    msg->obj = const_cast<TFW_TaskOps*>(ops);
+    msg->handler = const_cast<TFW_Handler*>(handler);
+    msg->FreeMessage = TaskFreeMessage;
+}
+
+int32_t TFW_PostTaskMessage(const TFW_Looper* looper, TFW_Message* msg, uint64_t delayMillis,
+    TFW_MessageHandle* handle) {
+    if (looper == nullptr) {
+        TFW_LOGE_CORE("Post task with null looper");
+        TaskFreeMessage(msg);
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (handle != nullptr) {
+        *handle = TFW_MessageGetHandle(msg);
+    }
+    // 失败时消息已由looper释放
+    int32_t ret = (delayMillis == 0) ? looper->PostMessage(looper, msg) :
+        looper->PostMessageDelay(looper, msg, delayMillis);
+    if (ret != TFW_SUCCESS) {
+        TFW_LOGE_CORE("Post task failed, ret: %d", ret);
+        if (handle != nullptr) {
+            *handle = TFW_MESSAGE_HANDLE_INVALID;
+        }
+    }
+    return ret;
+}
+
+int32_t TFW_PostTaskMessage(TFW_Strand* strand, TFW_Message* msg, uint64_t delayMillis) {
+    int32_t ret = TFW_StrandPostMessageDelay(strand, msg, delayMillis);
+    if (ret != TFW_SUCCESS) {
+        TFW_LOGE_CORE("Post task to strand failed, ret: %d", ret);
+    }
+    return ret;
+}
+
+int32_t TFW_PostTaskMessage(TFW_LooperGroup* group, uint64_t keyHash, TFW_Message* msg, uint64_t delayMillis) {
+    int32_t ret = TFW_LooperGroupPostMessageDelay(group, keyHash, msg, delayMillis);
+    if (ret != TFW_SUCCESS) {
+        TFW_LOGE_CORE("Post task to looper group failed, ret: %d", ret);
+    }
+    return ret;
+}
+
+} // namespace TFW
@@ -46,6 +46,9 @@ typedef enum {
     TFW_ERROR_LOCK_FAILED,             // Lock operation failed / 锁定操作失败
     TFW_ERROR_FILE_ERROR,              // File operation error / 文件操作错误
     TFW_ERROR_LOOPER_ERROR,            // Message loop error / 消息循环错误
+    TFW_ERROR_QUEUE_FULL,              // Queue full, message rejected / 队列已满，消息被拒绝
+    TFW_ERROR_MSG_DROPPED,             // Queue full, message dropped / 队列已满，消息被丢弃
+    TFW_ERROR_NOT_SUPPORTED,           // Not supported on this platform or configuration / 当前平台或配置不支持
 
     TFW_ERROR   = -1,                  // General error / 一般错误
     TFW_SUCCESS = 0                    // Success / 成功
@@ -172,6 +172,15 @@ bool TFW_AtomicCompareAndSwapPtr(TFW_AtomicPtr* atomic, void* expected, void* de
 #endif
 }
 
+void* TFW_AtomicExchangePtr(TFW_AtomicPtr* atomic, void* ptr) {
+#if TFW_USE_C11_ATOMICS
+    return atomic_exchange(&atomic->ptr, ptr);
+#else
+    // 使用平台特定的实现
+    return TFW_AtomicExchangePtr_Inner(atomic, ptr);
+#endif
+}
+
 // 内存屏障操作实现
 void TFW_MemoryBarrier(void) {
 #if TFW_USE_C11_ATOMICS
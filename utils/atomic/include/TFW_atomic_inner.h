@@ -31,6 +31,7 @@ void TFW_AtomicStore64_Inner(TFW_AtomicInt64* atomic, int64_t value);
 void* TFW_AtomicLoadPtr_Inner(TFW_AtomicPtr* atomic);
 void TFW_AtomicStorePtr_Inner(TFW_AtomicPtr* atomic, void* ptr);
 bool TFW_AtomicCompareAndSwapPtr_Inner(TFW_AtomicPtr* atomic, void* expected, void* desired);
+void* TFW_AtomicExchangePtr_Inner(TFW_AtomicPtr* atomic, void* ptr);
 
 // 内存屏障操作内部函数声明
 void TFW_MemoryBarrier_Inner(void);
@@ -75,6 +75,10 @@ bool TFW_AtomicCompareAndSwapPtr_Inner(TFW_AtomicPtr* atomic, void* expected, vo
                                       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
 }
 
+void* TFW_AtomicExchangePtr_Inner(TFW_AtomicPtr* atomic, void* ptr) {
+    return __atomic_exchange_n(&atomic->ptr, ptr, __ATOMIC_SEQ_CST);
+}
+
 void TFW_MemoryBarrier_Inner(void) {
     __atomic_thread_fence(__ATOMIC_SEQ_CST);
 }
@@ -72,6 +72,10 @@ bool TFW_AtomicCompareAndSwapPtr_Inner(TFW_AtomicPtr* atomic, void* expected, vo
     return InterlockedCompareExchangePointer((PVOID volatile*)&atomic->ptr, desired, expected) == expected;
 }
 
+void* TFW_AtomicExchangePtr_Inner(TFW_AtomicPtr* atomic, void* ptr) {
+    return InterlockedExchangePointer((PVOID volatile*)&atomic->ptr, ptr);
+}
+
 void TFW_MemoryBarrier_Inner(void) {
     MemoryBarrier();
 }
@@ -0,0 +1,378 @@
+#include "TFW_executor.h"
+
+#include <stdio.h>
+
+#include "TFW_atomic.h"
+#include "TFW_common_defines.h"
+#include "TFW_config.h"
+#include "TFW_errorno.h"
+#include "TFW_mem.h"
+#include "TFW_thread.h"
+#include "TFW_utils_log.h"
+
+#define EXECUTOR_NAME_LEN 16
+#define EXECUTOR_DEQUE_CAP 1024          // 每个工作线程本地队列容量，须为2的幂
+#define EXECUTOR_DEQUE_MASK (EXECUTOR_DEQUE_CAP - 1)
+#define EXECUTOR_INJECT_BATCH 32U        // 从注入队列一次取走的最大任务数
+
+// ============================================================================
+// 内部结构体定义
+// Internal structure definition
+// ============================================================================
+
+// Chase-Lev工作窃取队列：拥有者在bottom端push/pop，窃取者在top端steal
+typedef struct {
+    TFW_AtomicInt64 top;
+    TFW_AtomicInt64 bottom;
+    TFW_AtomicPtr buffer[EXECUTOR_DEQUE_CAP];
+} TFW_WorkDeque;
+
+typedef struct {
+    TFW_Executor *executor;
+    uint32_t index;
+    uint32_t randSeed;
+    TFW_Thread_t tid;
+    char name[EXECUTOR_NAME_LEN];
+    TFW_WorkDeque deque;
+} TFW_ExecutorWorker;
+
+struct TFW_Executor {
+    char name[EXECUTOR_NAME_LEN];
+    uint32_t workerCnt;
+    TFW_ExecutorWorker *workers;
+    // 全局注入队列：非工作线程提交的任务及本地队列溢出的任务
+    TFW_Mutex_t injectLock;
+    TFW_ExecutorTask *injectHead;
+    TFW_ExecutorTask *injectTail;
+    TFW_AtomicInt32 injectCnt;
+    // 空闲工作线程挂起
+    TFW_Mutex_t idleLock;
+    TFW_Cond_t idleCond;
+    TFW_AtomicInt32 sleeperCnt;
+    TFW_AtomicInt32 pendingCnt;      // 已提交尚未被取走的任务数
+    TFW_AtomicInt32 stop;
+};
+
+// 当前线程所属的工作线程，非工作线程为NULL
+static TFW_THREAD_LOCAL TFW_ExecutorWorker *g_currentWorker = NULL;
+
+// ============================================================================
+// Chase-Lev工作窃取队列
+// Chase-Lev work-stealing deque
+// ============================================================================
+
+// 仅拥有者调用；队列满时返回false
+static bool DequePush(TFW_WorkDeque *deque, TFW_ExecutorTask *task)
+{
+    int64_t bottom = TFW_AtomicLoad64(&deque->bottom);
+    int64_t top = TFW_AtomicLoad64(&deque->top);
+    if (bottom - top >= EXECUTOR_DEQUE_CAP) {
+        return false;
+    }
+    TFW_AtomicStorePtr(&deque->buffer[bottom & EXECUTOR_DEQUE_MASK], task);
+    TFW_AtomicStore64(&deque->bottom, bottom + 1);
+    return true;
+}
+
+// 仅拥有者调用；与窃取者争抢最后一个任务时通过CAS top决定归属
+static TFW_ExecutorTask *DequePop(TFW_WorkDeque *deque)
+{
+    int64_t bottom = TFW_AtomicLoad64(&deque->bottom) - 1;
+    TFW_AtomicStore64(&deque->bottom, bottom);
+    int64_t top = TFW_AtomicLoad64(&deque->top);
+    if (top > bottom) {
+        TFW_AtomicStore64(&deque->bottom, bottom + 1);
+        return NULL;
+    }
+    TFW_ExecutorTask *task = (TFW_ExecutorTask *)TFW_AtomicLoadPtr(&deque->buffer[bottom & EXECUTOR_DEQUE_MASK]);
+    if (top == bottom) {
+        if (!TFW_AtomicCompareAndSwap64(&deque->top, top, top + 1)) {
+            task = NULL;
+        }
+        TFW_AtomicStore64(&deque->bottom, bottom + 1);
+    }
+    return task;
+}
+
+// 任意线程调用；CAS失败表示与其他线程竞争，返回NULL由调用者换下一个目标
+static TFW_ExecutorTask *DequeSteal(TFW_WorkDeque *deque)
+{
+    int64_t top = TFW_AtomicLoad64(&deque->top);
+    int64_t bottom = TFW_AtomicLoad64(&deque->bottom);
+    if (top >= bottom) {
+        return NULL;
+    }
+    TFW_ExecutorTask *task = (TFW_ExecutorTask *)TFW_AtomicLoadPtr(&deque->buffer[top & EXECUTOR_DEQUE_MASK]);
+    if (!TFW_AtomicCompareAndSwap64(&deque->top, top, top + 1)) {
+        return NULL;
+    }
+    return task;
+}
+
+// ============================================================================
+// 注入队列与调度
+// Injection queue and scheduling
+// ============================================================================
+
+static void InjectPush(TFW_Executor *executor, TFW_ExecutorTask *task)
+{
+    task->next = NULL;
+    (void)TFW_Mutex_Lock(&executor->injectLock);
+    if (executor->injectTail == NULL) {
+        executor->injectHead = task;
+    } else {
+        executor->injectTail->next = task;
+    }
+    executor->injectTail = task;
+    (void)TFW_AtomicInc32(&executor->injectCnt);
+    (void)TFW_Mutex_Unlock(&executor->injectLock);
+}
+
+// 从注入队列取一个任务执行，并顺带将至多EXECUTOR_INJECT_BATCH个任务转移到本地队列
+static TFW_ExecutorTask *InjectPop(TFW_Executor *executor, TFW_ExecutorWorker *worker)
+{
+    if (TFW_AtomicLoad32(&executor->injectCnt) == 0) {
+        return NULL;
+    }
+    (void)TFW_Mutex_Lock(&executor->injectLock);
+    TFW_ExecutorTask *task = executor->injectHead;
+    if (task != NULL) {
+        executor->injectHead = task->next;
+        (void)TFW_AtomicDec32(&executor->injectCnt);
+        for (uint32_t i = 0; i < EXECUTOR_INJECT_BATCH && executor->injectHead != NULL; i++) {
+            TFW_ExecutorTask *extra = executor->injectHead;
+            if (!DequePush(&worker->deque, extra)) {
+                break;
+            }
+            executor->injectHead = extra->next;
+            (void)TFW_AtomicDec32(&executor->injectCnt);
+        }
+        if (executor->injectHead == NULL) {
+            executor->injectTail = NULL;
+        }
+    }
+    (void)TFW_Mutex_Unlock(&executor->injectLock);
+    return task;
+}
+
+static uint32_t NextRandom(TFW_ExecutorWorker *worker)
+{
+    // xorshift32
+    uint32_t x = worker->randSeed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    worker->randSeed = x;
+    return x;
+}
+
+static TFW_ExecutorTask *StealFromOthers(TFW_Executor *executor, TFW_ExecutorWorker *worker)
+{
+    uint32_t start = NextRandom(worker) % executor->workerCnt;
+    for (uint32_t i = 0; i < executor->workerCnt; i++) {
+        TFW_ExecutorWorker *victim = &executor->workers[(start + i) % executor->workerCnt];
+        if (victim == worker) {
+            continue;
+        }
+        TFW_ExecutorTask *task = DequeSteal(&victim->deque);
+        if (task != NULL) {
+            return task;
+        }
+    }
+    return NULL;
+}
+
+static TFW_ExecutorTask *FindTask(TFW_Executor *executor, TFW_ExecutorWorker *worker)
+{
+    TFW_ExecutorTask *task = DequePop(&worker->deque);
+    if (task == NULL) {
+        task = InjectPop(executor, worker);
+    }
+    if (task == NULL) {
+        task = StealFromOthers(executor, worker);
+    }
+    return task;
+}
+
+// 仅在存在挂起的工作线程时才加锁唤醒；与WorkerPark中的sleeperCnt/pendingCnt构成Dekker式检查
+static void WakeWorker(TFW_Executor *executor)
+{
+    if (TFW_AtomicLoad32(&executor->sleeperCnt) == 0) {
+        return;
+    }
+    (void)TFW_Mutex_Lock(&executor->idleLock);
+    TFW_Cond_Signal(&executor->idleCond);
+    (void)TFW_Mutex_Unlock(&executor->idleLock);
+}
+
+// 挂起直至有新任务或执行器停止；返回true表示工作线程应退出
+static bool WorkerPark(TFW_Executor *executor)
+{
+    bool shouldExit = false;
+    (void)TFW_Mutex_Lock(&executor->idleLock);
+    (void)TFW_AtomicInc32(&executor->sleeperCnt);
+    if (TFW_AtomicLoad32(&executor->pendingCnt) == 0) {
+        if (TFW_AtomicLoad32(&executor->stop) != 0) {
+            shouldExit = true;
+        } else {
+            TFW_Cond_Wait(&executor->idleCond, &executor->idleLock, NULL);
+        }
+    }
+    (void)TFW_AtomicDec32(&executor->sleeperCnt);
+    (void)TFW_Mutex_Unlock(&executor->idleLock);
+    return shouldExit;
+}
+
+static void *WorkerTask(void *arg)
+{
+    TFW_ExecutorWorker *worker = (TFW_ExecutorWorker *)arg;
+    TFW_Executor *executor = worker->executor;
+    g_currentWorker = worker;
+    TFW_LOGD_UTILS("executor worker running. name=%s", worker->name);
+
+    for (;;) {
+        TFW_ExecutorTask *task = FindTask(executor, worker);
+        if (task != NULL) {
+            (void)TFW_AtomicDec32(&executor->pendingCnt);
+            // 本地仍有积压时唤醒其他线程协助窃取
+            if (TFW_AtomicLoad64(&worker->deque.bottom) > TFW_AtomicLoad64(&worker->deque.top)) {
+                WakeWorker(executor);
+            }
+            task->Run(task);
+            continue;
+        }
+        if (WorkerPark(executor)) {
+            break;
+        }
+    }
+
+    g_currentWorker = NULL;
+    TFW_LOGD_UTILS("executor worker exit. name=%s", worker->name);
+    return NULL;
+}
+
+// ============================================================================
+// 公共接口实现
+// Public interface implementation
+// ============================================================================
+
+static uint32_t GetConfiguredWorkerCount(void)
+{
+    int32_t maxThreads = TFW_CONFIG_DEFAULT_SYSTEM_MAX_THREADS;
+    if (TFW_ConfigGetInt(TFW_CONFIG_SYSTEM_MAX_THREADS, &maxThreads) != TFW_SUCCESS || maxThreads <= 0) {
+        TFW_LOGW_UTILS("invalid system.max_threads, use default %d", TFW_CONFIG_DEFAULT_SYSTEM_MAX_THREADS);
+        maxThreads = TFW_CONFIG_DEFAULT_SYSTEM_MAX_THREADS;
+    }
+    return (uint32_t)maxThreads;
+}
+
+static void ExecutorFree(TFW_Executor *executor)
+{
+    TFW_Cond_Destroy(&executor->idleCond);
+    TFW_Mutex_Destroy(&executor->idleLock);
+    TFW_Mutex_Destroy(&executor->injectLock);
+    TFW_Free(executor->workers);
+    TFW_Free(executor);
+}
+
+// 停止执行器并回收已启动的工作线程，工作线程在队列清空后退出
+static void ExecutorStopWorkers(TFW_Executor *executor, uint32_t startedCnt)
+{
+    (void)TFW_Mutex_Lock(&executor->idleLock);
+    TFW_AtomicStore32(&executor->stop, 1);
+    TFW_Cond_Broadcast(&executor->idleCond);
+    (void)TFW_Mutex_Unlock(&executor->idleLock);
+    for (uint32_t i = 0; i < startedCnt; i++) {
+        (void)TFW_Thread_Join(executor->workers[i].tid, NULL);
+    }
+}
+
+TFW_Executor *TFW_ExecutorCreate(const char *name, uint32_t workerCnt)
+{
+    if (workerCnt == 0) {
+        workerCnt = GetConfiguredWorkerCount();
+    }
+    if (workerCnt > TFW_EXECUTOR_MAX_WORKERS) {
+        workerCnt = TFW_EXECUTOR_MAX_WORKERS;
+    }
+
+    TFW_Executor *executor = (TFW_Executor *)TFW_Calloc(sizeof(TFW_Executor));
+    if (executor == NULL) {
+        TFW_LOGE_UTILS("executor TFW_Calloc fail");
+        return NULL;
+    }
+    executor->workers = (TFW_ExecutorWorker *)TFW_Calloc((uint32_t)(sizeof(TFW_ExecutorWorker) * workerCnt));
+    if (executor->workers == NULL) {
+        TFW_LOGE_UTILS("executor workers TFW_Calloc fail");
+        TFW_Free(executor);
+        return NULL;
+    }
+    (void)snprintf(executor->name, sizeof(executor->name), "%s",
+        (name != NULL) ? name : TFW_DEFAULT_EXECUTOR_NAME);
+    executor->workerCnt = workerCnt;
+
+    TFW_Mutex_Init(&executor->injectLock, NULL);
+    TFW_Mutex_Init(&executor->idleLock, NULL);
+    TFW_Cond_Init(&executor->idleCond);
+
+    for (uint32_t i = 0; i < workerCnt; i++) {
+        TFW_ExecutorWorker *worker = &executor->workers[i];
+        worker->executor = executor;
+        worker->index = i;
+        worker->randSeed = i + 1;
+        (void)snprintf(worker->name, sizeof(worker->name), "%.10s_%u", executor->name, (uint32_t)(uint8_t)i);
+
+        TFW_ThreadAttr threadAttr;
+        TFW_ThreadAttr_Init(&threadAttr);
+        threadAttr.name = worker->name;
+        if (TFW_Thread_Create(&worker->tid, &threadAttr, WorkerTask, worker) != TFW_SUCCESS) {
+            TFW_LOGE_UTILS("executor worker create fail. name=%s", worker->name);
+            ExecutorStopWorkers(executor, i);
+            ExecutorFree(executor);
+            return NULL;
+        }
+    }
+
+    TFW_LOGI_UTILS("executor created. name=%s, workers=%u", executor->name, workerCnt);
+    return executor;
+}
+
+void TFW_ExecutorDestroy(TFW_Executor *executor)
+{
+    if (executor == NULL) {
+        TFW_LOGE_UTILS("executor is null");
+        return;
+    }
+    ExecutorStopWorkers(executor, executor->workerCnt);
+    TFW_LOGI_UTILS("executor destroyed. name=%s", executor->name);
+    ExecutorFree(executor);
+}
+
+int32_t TFW_ExecutorSubmit(TFW_Executor *executor, TFW_ExecutorTask *task)
+{
+    if (executor == NULL || task == NULL || task->Run == NULL) {
+        TFW_LOGE_UTILS("invalid executor or task");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (TFW_AtomicLoad32(&executor->stop) != 0) {
+        TFW_LOGE_UTILS("executor is stopping. name=%s", executor->name);
+        return TFW_ERROR;
+    }
+
+    // 先计数再入队，保证工作线程挂起前的检查不会漏掉该任务
+    (void)TFW_AtomicInc32(&executor->pendingCnt);
+    TFW_ExecutorWorker *worker = g_currentWorker;
+    if (worker == NULL || worker->executor != executor || !DequePush(&worker->deque, task)) {
+        InjectPush(executor, task);
+    }
+    WakeWorker(executor);
+    return TFW_SUCCESS;
+}
+
+uint32_t TFW_ExecutorGetWorkerCount(const TFW_Executor *executor)
+{
+    if (executor == NULL) {
+        return 0;
+    }
+    return executor->workerCnt;
+}
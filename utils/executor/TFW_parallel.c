@@ -0,0 +1,362 @@
+#include "TFW_parallel.h"
+
+#include <stdlib.h>
+
+#include "TFW_atomic.h"
+#include "TFW_common_defines.h"
+#include "TFW_errorno.h"
+#include "TFW_executor.h"
+#include "TFW_list.h"
+#include "TFW_mem.h"
+#include "TFW_message_loop.h"
+#include "TFW_thread.h"
+#include "TFW_utils_log.h"
+
+#define PARALLEL_CHUNKS_PER_SLOT 4U      // 每次领取剩余量的1/(参与者数*4)，剩余越少切分越细
+#define PARALLEL_SORT_MIN_RUN 2048U      // 不足两段时直接qsort
+
+// ============================================================================
+// 内部结构体定义
+// Internal structure definition
+// ============================================================================
+
+typedef struct TFW_ParallelJob TFW_ParallelJob;
+
+typedef struct {
+    TFW_ExecutorTask task;
+    TFW_ParallelJob *job;
+} TFW_ParallelHelper;
+
+// 调用者与辅助任务共享，引用计数归零时释放；调用者只等待区间完成，不等待排队中的辅助任务
+struct TFW_ParallelJob {
+    TFW_AtomicInt32 refCnt;
+    TFW_AtomicInt32 slotSeq;
+    TFW_AtomicInt64 next;       // 下一个待领取的偏移
+    TFW_AtomicInt64 pending;    // 尚未处理完的元素数
+    size_t begin;
+    size_t count;
+    size_t grain;
+    uint32_t slotCnt;
+    TFW_ParallelForFunc fn;
+    void *arg;
+    TFW_Mutex_t lock;
+    TFW_Cond_t cond;
+    TFW_ParallelHelper helpers[];
+};
+
+typedef struct {
+    uint8_t *partials;
+    size_t size;
+    TFW_ParallelReduceFunc reduceFn;
+    void *arg;
+} TFW_ParallelReduceArgs;
+
+typedef struct {
+    uint8_t *src;
+    uint8_t *dst;
+    size_t count;
+    size_t size;
+    size_t width;
+    size_t parts;
+    TFW_ParallelCompareFunc cmp;
+} TFW_ParallelSortArgs;
+
+// ============================================================================
+// fork-join调度
+// Fork-join scheduling
+// ============================================================================
+
+// 自适应切分：按剩余量与参与者数决定本次领取大小，不小于grain
+static bool ClaimChunk(TFW_ParallelJob *job, size_t *chunkBegin, size_t *chunkEnd)
+{
+    int64_t count = (int64_t)job->count;
+    int64_t cur = TFW_AtomicLoad64(&job->next);
+    for (;;) {
+        if (cur >= count) {
+            return false;
+        }
+        int64_t remaining = count - cur;
+        int64_t take = remaining / (int64_t)(job->slotCnt * PARALLEL_CHUNKS_PER_SLOT);
+        if (take < (int64_t)job->grain) {
+            take = (int64_t)job->grain;
+        }
+        if (take > remaining) {
+            take = remaining;
+        }
+        if (TFW_AtomicCompareAndSwap64(&job->next, cur, cur + take)) {
+            *chunkBegin = job->begin + (size_t)cur;
+            *chunkEnd = job->begin + (size_t)(cur + take);
+            return true;
+        }
+        cur = TFW_AtomicLoad64(&job->next);
+    }
+}
+
+static void RunSlot(TFW_ParallelJob *job, uint32_t slot)
+{
+    size_t chunkBegin = 0;
+    size_t chunkEnd = 0;
+    while (ClaimChunk(job, &chunkBegin, &chunkEnd)) {
+        job->fn(chunkBegin, chunkEnd, slot, job->arg);
+        if (TFW_AtomicSub64(&job->pending, (int64_t)(chunkEnd - chunkBegin)) == 0) {
+            (void)TFW_Mutex_Lock(&job->lock);
+            TFW_Cond_Broadcast(&job->cond);
+            (void)TFW_Mutex_Unlock(&job->lock);
+        }
+    }
+}
+
+static void ReleaseJob(TFW_ParallelJob *job)
+{
+    if (TFW_AtomicDec32(&job->refCnt) != 0) {
+        return;
+    }
+    TFW_Cond_Destroy(&job->cond);
+    TFW_Mutex_Destroy(&job->lock);
+    TFW_Free(job);
+}
+
+// 排队较久的辅助任务可能在区间已领完后才执行，此时直接释放引用
+static void HelperRun(TFW_ExecutorTask *task)
+{
+    TFW_ParallelHelper *helper = TFW_CONTAINER_OF(task, TFW_ParallelHelper, task);
+    TFW_ParallelJob *job = helper->job;
+    uint32_t slot = (uint32_t)TFW_AtomicInc32(&job->slotSeq);
+    RunSlot(job, slot);
+    ReleaseJob(job);
+}
+
+static TFW_ParallelJob *CreateJob(size_t begin, size_t count, size_t grain, uint32_t helperCnt)
+{
+    uint32_t jobSize = (uint32_t)(sizeof(TFW_ParallelJob) + sizeof(TFW_ParallelHelper) * helperCnt);
+    TFW_ParallelJob *job = (TFW_ParallelJob *)TFW_Calloc(jobSize);
+    if (job == NULL) {
+        return NULL;
+    }
+    TFW_AtomicStore32(&job->refCnt, (int32_t)helperCnt + 1);
+    TFW_AtomicStore64(&job->pending, (int64_t)count);
+    job->begin = begin;
+    job->count = count;
+    job->grain = grain;
+    job->slotCnt = helperCnt + 1;
+    TFW_Mutex_Init(&job->lock, NULL);
+    TFW_Cond_Init(&job->cond);
+    return job;
+}
+
+// ============================================================================
+// 公共接口实现
+// Public interface implementation
+// ============================================================================
+
+uint32_t TFW_ParallelConcurrency(void)
+{
+    return TFW_ExecutorGetWorkerCount(TFW_GetDefaultExecutor()) + 1;
+}
+
+int32_t TFW_ParallelFor(size_t begin, size_t end, size_t grain, TFW_ParallelForFunc fn, void *arg)
+{
+    if (fn == NULL || begin > end) {
+        TFW_LOGE_UTILS("invalid parallel range or func");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    size_t count = end - begin;
+    if (count == 0) {
+        return TFW_SUCCESS;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+    TFW_Executor *executor = TFW_GetDefaultExecutor();
+    size_t chunkCnt = (count + grain - 1) / grain;
+    uint32_t helperCnt = TFW_ExecutorGetWorkerCount(executor);
+    if ((size_t)helperCnt > chunkCnt - 1) {
+        helperCnt = (uint32_t)(chunkCnt - 1);
+    }
+    TFW_ParallelJob *job = (helperCnt == 0) ? NULL : CreateJob(begin, count, grain, helperCnt);
+    if (job == NULL) {
+        // 无执行器、区间过小或内存不足时在调用线程上串行执行
+        fn(begin, end, 0, arg);
+        return TFW_SUCCESS;
+    }
+    job->fn = fn;
+    job->arg = arg;
+    for (uint32_t i = 0; i < helperCnt; i++) {
+        TFW_ParallelHelper *helper = &job->helpers[i];
+        helper->job = job;
+        helper->task.Run = HelperRun;
+        if (TFW_ExecutorSubmit(executor, &helper->task) != TFW_SUCCESS) {
+            ReleaseJob(job);
+        }
+    }
+
+    RunSlot(job, 0);
+    (void)TFW_Mutex_Lock(&job->lock);
+    while (TFW_AtomicLoad64(&job->pending) != 0) {
+        TFW_Cond_Wait(&job->cond, &job->lock, NULL);
+    }
+    (void)TFW_Mutex_Unlock(&job->lock);
+    ReleaseJob(job);
+    return TFW_SUCCESS;
+}
+
+static void ReduceChunk(size_t begin, size_t end, uint32_t slot, void *arg)
+{
+    TFW_ParallelReduceArgs *reduce = (TFW_ParallelReduceArgs *)arg;
+    reduce->reduceFn(begin, end, reduce->partials + reduce->size * slot, reduce->arg);
+}
+
+int32_t TFW_ParallelReduce(size_t begin, size_t end, size_t grain, void *result, size_t resultSize,
+    TFW_ParallelReduceFunc reduceFn, TFW_ParallelCombineFunc combineFn, void *arg)
+{
+    if (result == NULL || resultSize == 0 || reduceFn == NULL || combineFn == NULL || begin > end) {
+        TFW_LOGE_UTILS("invalid parallel reduce param");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    uint32_t slotCnt = TFW_ParallelConcurrency();
+    if (slotCnt == 1 || (uint64_t)resultSize * slotCnt > UINT32_MAX) {
+        reduceFn(begin, end, result, arg);
+        return TFW_SUCCESS;
+    }
+    uint8_t *partials = (uint8_t *)TFW_Malloc((uint32_t)(resultSize * slotCnt));
+    if (partials == NULL) {
+        TFW_LOGW_UTILS("parallel reduce TFW_Malloc fail, run serially");
+        reduceFn(begin, end, result, arg);
+        return TFW_SUCCESS;
+    }
+    // 每个参与者的部分结果都从单位元开始，未参与的slot保持单位元，合并后不影响结果
+    for (uint32_t i = 0; i < slotCnt; i++) {
+        (void)TFW_Memcpy_S(partials + resultSize * i, resultSize, result, resultSize);
+    }
+    TFW_ParallelReduceArgs reduce = { partials, resultSize, reduceFn, arg };
+    int32_t ret = TFW_ParallelFor(begin, end, grain, ReduceChunk, &reduce);
+    if (ret == TFW_SUCCESS) {
+        for (uint32_t i = 0; i < slotCnt; i++) {
+            combineFn(result, partials + resultSize * i, arg);
+        }
+    }
+    TFW_Free(partials);
+    return ret;
+}
+
+static void SortRuns(size_t begin, size_t end, uint32_t slot, void *arg)
+{
+    (void)slot;
+    TFW_ParallelSortArgs *sort = (TFW_ParallelSortArgs *)arg;
+    for (size_t run = begin; run < end; run++) {
+        size_t lo = run * sort->width;
+        size_t hi = (lo + sort->width < sort->count) ? lo + sort->width : sort->count;
+        qsort(sort->src + lo * sort->size, hi - lo, sort->size, sort->cmp);
+    }
+}
+
+// 归并src中的[i, iEnd)与[j, jEnd)到dst的out处，相等时取左侧
+static void MergeRange(const TFW_ParallelSortArgs *sort, size_t i, size_t iEnd, size_t j, size_t jEnd, size_t out)
+{
+    size_t size = sort->size;
+    uint8_t *dst = sort->dst + out * size;
+    uint8_t *dstEnd = sort->dst + sort->count * size;
+    while (i < iEnd && j < jEnd) {
+        const uint8_t *left = sort->src + i * size;
+        const uint8_t *right = sort->src + j * size;
+        if (sort->cmp(right, left) < 0) {
+            (void)TFW_Memcpy_S(dst, (size_t)(dstEnd - dst), right, size);
+            j++;
+        } else {
+            (void)TFW_Memcpy_S(dst, (size_t)(dstEnd - dst), left, size);
+            i++;
+        }
+        dst += size;
+    }
+    if (i < iEnd) {
+        (void)TFW_Memcpy_S(dst, (size_t)(dstEnd - dst), sort->src + i * size, (iEnd - i) * size);
+    } else if (j < jEnd) {
+        (void)TFW_Memcpy_S(dst, (size_t)(dstEnd - dst), sort->src + j * size, (jEnd - j) * size);
+    }
+}
+
+// 二分查找合并结果前k个元素中来自左段的个数，使一对段可以切成多份并行归并
+static size_t MergeSplit(const TFW_ParallelSortArgs *sort, size_t lo, size_t mid, size_t hi, size_t k)
+{
+    size_t leftCnt = mid - lo;
+    size_t rightCnt = hi - mid;
+    size_t low = (k > rightCnt) ? k - rightCnt : 0;
+    size_t high = (k < leftCnt) ? k : leftCnt;
+    while (low < high) {
+        size_t i = low + (high - low) / 2;
+        size_t j = k - i;
+        // 左段第i个不大于右段第j-1个时，它必然在前k个之中
+        if (j > 0 && sort->cmp(sort->src + (mid + j - 1) * sort->size, sort->src + (lo + i) * sort->size) >= 0) {
+            low = i + 1;
+        } else {
+            high = i;
+        }
+    }
+    return low;
+}
+
+// 任务数不足参与者数时每对段切成parts份，保证最后几层归并同样并行
+static void MergePairs(size_t begin, size_t end, uint32_t slot, void *arg)
+{
+    (void)slot;
+    TFW_ParallelSortArgs *sort = (TFW_ParallelSortArgs *)arg;
+    for (size_t task = begin; task < end; task++) {
+        size_t lo = (task / sort->parts) * sort->width * 2;
+        size_t part = task % sort->parts;
+        size_t mid = (lo + sort->width < sort->count) ? lo + sort->width : sort->count;
+        size_t hi = (mid + sort->width < sort->count) ? mid + sort->width : sort->count;
+        size_t first = (hi - lo) * part / sort->parts;
+        size_t last = (hi - lo) * (part + 1) / sort->parts;
+        size_t i = MergeSplit(sort, lo, mid, hi, first);
+        size_t iEnd = MergeSplit(sort, lo, mid, hi, last);
+        MergeRange(sort, lo + i, lo + iEnd, mid + (first - i), mid + (last - iEnd), lo + first);
+    }
+}
+
+int32_t TFW_ParallelSort(void *base, size_t count, size_t size, TFW_ParallelCompareFunc cmp)
+{
+    if ((base == NULL && count != 0) || size == 0 || cmp == NULL) {
+        TFW_LOGE_UTILS("invalid parallel sort param");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    // 不足两个元素时无需排序，且base可能为NULL，不能传给qsort
+    if (count < 2) {
+        return TFW_SUCCESS;
+    }
+    uint32_t slotCnt = TFW_ParallelConcurrency();
+    if (slotCnt == 1 || count < PARALLEL_SORT_MIN_RUN * 2) {
+        qsort(base, count, size, cmp);
+        return TFW_SUCCESS;
+    }
+    if ((uint64_t)count * size > UINT32_MAX) {
+        TFW_LOGE_UTILS("parallel sort array too large. count=%zu, size=%zu", count, size);
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    uint8_t *buffer = (uint8_t *)TFW_Malloc((uint32_t)(count * size));
+    if (buffer == NULL) {
+        TFW_LOGE_UTILS("parallel sort TFW_Malloc fail");
+        return TFW_ERROR_MALLOC_ERR;
+    }
+
+    // 每个参与者一段，段长不小于PARALLEL_SORT_MIN_RUN
+    size_t width = (count + slotCnt - 1) / slotCnt;
+    if (width < PARALLEL_SORT_MIN_RUN) {
+        width = PARALLEL_SORT_MIN_RUN;
+    }
+    TFW_ParallelSortArgs sort = { (uint8_t *)base, buffer, count, size, width, 1, cmp };
+    (void)TFW_ParallelFor(0, (count + width - 1) / width, 1, SortRuns, &sort);
+    // 逐层两两归并，src与dst交替
+    for (; sort.width < count; sort.width *= 2) {
+        size_t pairCnt = (count + sort.width * 2 - 1) / (sort.width * 2);
+        sort.parts = (pairCnt < slotCnt) ? (slotCnt + pairCnt - 1) / pairCnt : 1;
+        (void)TFW_ParallelFor(0, pairCnt * sort.parts, 1, MergePairs, &sort);
+        uint8_t *swap = sort.src;
+        sort.src = sort.dst;
+        sort.dst = swap;
+    }
+    if (sort.src != (uint8_t *)base) {
+        (void)TFW_Memcpy_S(base, count * size, sort.src, count * size);
+    }
+    TFW_Free(buffer);
+    return TFW_SUCCESS;
+}
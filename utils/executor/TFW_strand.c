@@ -0,0 +1,312 @@
+#include "TFW_strand.h"
+
+#include <stdio.h>
+
+#include "TFW_atomic.h"
+#include "TFW_common_defines.h"
+#include "TFW_errorno.h"
+#include "TFW_mem.h"
+#include "TFW_thread.h"
+#include "TFW_utils_log.h"
+
+#define STRAND_NAME_LEN 16
+#define STRAND_RUN_BUDGET 64U            // 单次调度最多执行的消息数，之后让出工作线程
+#define STRAND_TIMER_HANDLER_NAME "TFW_StrandTimer"
+
+// ============================================================================
+// 内部结构体定义
+// Internal structure definition
+// ============================================================================
+
+enum {
+    STRAND_LOCK_UNINIT = 0,
+    STRAND_LOCK_INITING,
+    STRAND_LOCK_READY,
+};
+
+// 引用由创建者、已提交的调度任务和在途的延时消息各持有一份，归零时释放strand及残留消息
+struct TFW_Strand {
+    TFW_ExecutorTask task;
+    TFW_Executor *executor;
+    TFW_AtomicPtr inbox;          // 生产者端：无锁栈，消费者一次取走后翻转为FIFO
+    TFW_Message *local;           // 消费者端：已翻转的待执行消息，仅由当前调度任务访问
+    TFW_AtomicInt32 scheduled;    // 调度任务已提交或正在执行
+    TFW_AtomicInt32 running;      // 正在执行消息
+    TFW_AtomicInt32 closed;
+    TFW_AtomicInt32 waiters;      // 在TFW_StrandDestroy中等待的线程数
+    TFW_AtomicInt32 refs;
+    char name[STRAND_NAME_LEN];
+};
+
+// 当前线程正在执行的strand
+static TFW_THREAD_LOCAL const TFW_Strand *g_currentStrand = NULL;
+
+// 销毁时等待执行结束，所有strand共用；只在销毁与确有等待者时加锁
+static TFW_AtomicInt32 g_strandLockState;
+static TFW_Mutex_t g_strandLock;
+static TFW_MutexAttr_t g_strandLockAttr;
+static TFW_Cond_t g_strandCond;
+
+static void StrandLock(void)
+{
+    if (TFW_AtomicLoad32(&g_strandLockState) != STRAND_LOCK_READY) {
+        if (TFW_AtomicCompareAndSwap32(&g_strandLockState, STRAND_LOCK_UNINIT, STRAND_LOCK_INITING)) {
+            TFW_MutexAttr_Init(&g_strandLockAttr);
+            TFW_Mutex_Init(&g_strandLock, &g_strandLockAttr);
+            TFW_Cond_Init(&g_strandCond);
+            TFW_AtomicStore32(&g_strandLockState, STRAND_LOCK_READY);
+        }
+        while (TFW_AtomicLoad32(&g_strandLockState) != STRAND_LOCK_READY) {
+        }
+    }
+    (void)TFW_Mutex_Lock(&g_strandLock);
+}
+
+static void StrandUnlock(void)
+{
+    (void)TFW_Mutex_Unlock(&g_strandLock);
+}
+
+// ============================================================================
+// 消息队列
+// Message queue
+// ============================================================================
+
+static TFW_Message *NextOf(TFW_Message *msg)
+{
+    return (TFW_Message *)TFW_AtomicLoadPtr(&msg->link.next);
+}
+
+static void InboxPush(TFW_Strand *strand, TFW_Message *msg)
+{
+    void *head = NULL;
+    do {
+        head = TFW_AtomicLoadPtr(&strand->inbox);
+        TFW_AtomicStorePtr(&msg->link.next, head);
+    } while (!TFW_AtomicCompareAndSwapPtr(&strand->inbox, head, msg));
+}
+
+// 取走无锁栈中的全部消息并翻转为投递顺序
+static TFW_Message *InboxTakeAll(TFW_Strand *strand)
+{
+    TFW_Message *msg = (TFW_Message *)TFW_AtomicExchangePtr(&strand->inbox, NULL);
+    TFW_Message *fifo = NULL;
+    while (msg != NULL) {
+        TFW_Message *next = NextOf(msg);
+        TFW_AtomicStorePtr(&msg->link.next, fifo);
+        fifo = msg;
+        msg = next;
+    }
+    return fifo;
+}
+
+static void FreeMessageList(TFW_Message *msg)
+{
+    while (msg != NULL) {
+        TFW_Message *next = NextOf(msg);
+        TFW_FreeMessage(msg);
+        msg = next;
+    }
+}
+
+// ============================================================================
+// 调度
+// Scheduling
+// ============================================================================
+
+static void ReleaseStrand(TFW_Strand *strand)
+{
+    if (TFW_AtomicDec32(&strand->refs) != 0) {
+        return;
+    }
+    FreeMessageList(strand->local);
+    FreeMessageList(InboxTakeAll(strand));
+    TFW_LOGD_UTILS("strand freed. name=%s", strand->name);
+    TFW_Free(strand);
+}
+
+static void StrandRun(TFW_ExecutorTask *task);
+
+// 调度任务持有一份引用，直到不再重新提交
+static void ScheduleStrand(TFW_Strand *strand)
+{
+    if (!TFW_AtomicCompareAndSwap32(&strand->scheduled, 0, 1)) {
+        return;
+    }
+    (void)TFW_AtomicInc32(&strand->refs);
+    strand->task.Run = StrandRun;
+    if (TFW_ExecutorSubmit(strand->executor, &strand->task) != TFW_SUCCESS) {
+        TFW_LOGE_UTILS("submit strand failed. name=%s", strand->name);
+        TFW_AtomicStore32(&strand->scheduled, 0);
+        ReleaseStrand(strand);
+    }
+}
+
+// 与TFW_StrandDestroy构成Dekker式检查：先置running再检查closed，销毁方先置closed再检查running
+static void RunMessages(TFW_Strand *strand)
+{
+    TFW_AtomicStore32(&strand->running, 1);
+    const TFW_Strand *prev = g_currentStrand;
+    g_currentStrand = strand;
+    if (strand->local == NULL) {
+        strand->local = InboxTakeAll(strand);
+    }
+    for (uint32_t i = 0; i < STRAND_RUN_BUDGET && strand->local != NULL; i++) {
+        TFW_Message *msg = strand->local;
+        strand->local = NextOf(msg);
+        if (TFW_AtomicLoad32(&strand->closed) == 0 && msg->handler->HandleMessage != NULL) {
+            msg->handler->HandleMessage(msg);
+        }
+        TFW_FreeMessage(msg);
+    }
+    g_currentStrand = prev;
+    TFW_AtomicStore32(&strand->running, 0);
+    if (TFW_AtomicLoad32(&strand->waiters) != 0) {
+        StrandLock();
+        TFW_Cond_Broadcast(&g_strandCond);
+        StrandUnlock();
+    }
+}
+
+static void StrandRun(TFW_ExecutorTask *task)
+{
+    TFW_Strand *strand = TFW_CONTAINER_OF(task, TFW_Strand, task);
+    RunMessages(strand);
+    // 仍有积压时重新排队，让同一工作线程上的其他strand得到执行
+    if (strand->local != NULL || TFW_AtomicLoadPtr(&strand->inbox) != NULL) {
+        if (TFW_ExecutorSubmit(strand->executor, &strand->task) == TFW_SUCCESS) {
+            return;
+        }
+        TFW_LOGE_UTILS("resubmit strand failed. name=%s", strand->name);
+    }
+    TFW_AtomicStore32(&strand->scheduled, 0);
+    // 清除标志后再次检查，避免与投递方的判空交错而丢失调度
+    if (TFW_AtomicLoadPtr(&strand->inbox) != NULL && TFW_AtomicLoad32(&strand->closed) == 0) {
+        ScheduleStrand(strand);
+    }
+    ReleaseStrand(strand);
+}
+
+// ============================================================================
+// 延时投递：默认looper上的计时消息持有strand引用，到期后转投
+// Delayed post: a timer message on the default looper holds a strand reference and forwards when due
+// ============================================================================
+
+static void StrandTimerHandle(TFW_Message *timer)
+{
+    TFW_Message *msg = (TFW_Message *)(uintptr_t)timer->arg1;
+    timer->arg1 = 0;
+    (void)TFW_StrandPostMessage((TFW_Strand *)timer->obj, msg);
+}
+
+// 计时消息被移除或looper销毁时释放尚未转投的消息
+static void StrandTimerFree(TFW_Message *timer)
+{
+    if (timer->arg1 != 0) {
+        TFW_FreeMessage((TFW_Message *)(uintptr_t)timer->arg1);
+    }
+    ReleaseStrand((TFW_Strand *)timer->obj);
+    timer->FreeMessage = NULL;
+    TFW_FreeMessage(timer);
+}
+
+static TFW_Handler g_strandTimerHandler = { STRAND_TIMER_HANDLER_NAME, NULL, StrandTimerHandle };
+
+// ============================================================================
+// 公共接口实现
+// Public interface implementation
+// ============================================================================
+
+TFW_Strand *TFW_StrandCreate(const char *name, TFW_Executor *executor)
+{
+    if (executor == NULL) {
+        executor = TFW_GetDefaultExecutor();
+    }
+    if (executor == NULL) {
+        TFW_LOGE_UTILS("strand needs an executor, call TFW_LooperInit first");
+        return NULL;
+    }
+    TFW_Strand *strand = (TFW_Strand *)TFW_Calloc(sizeof(TFW_Strand));
+    if (strand == NULL) {
+        TFW_LOGE_UTILS("strand TFW_Calloc fail");
+        return NULL;
+    }
+    strand->executor = executor;
+    TFW_AtomicStore32(&strand->refs, 1);
+    (void)snprintf(strand->name, sizeof(strand->name), "%s", (name != NULL) ? name : "TFW_Strand");
+    TFW_LOGD_UTILS("strand created. name=%s", strand->name);
+    return strand;
+}
+
+void TFW_StrandDestroy(TFW_Strand *strand)
+{
+    if (strand == NULL) {
+        TFW_LOGE_UTILS("strand is null");
+        return;
+    }
+    TFW_AtomicStore32(&strand->closed, 1);
+    if (g_currentStrand != strand && TFW_AtomicLoad32(&strand->running) != 0) {
+        StrandLock();
+        (void)TFW_AtomicInc32(&strand->waiters);
+        while (TFW_AtomicLoad32(&strand->running) != 0) {
+            TFW_Cond_Wait(&g_strandCond, &g_strandLock, NULL);
+        }
+        (void)TFW_AtomicDec32(&strand->waiters);
+        StrandUnlock();
+    }
+    ReleaseStrand(strand);
+}
+
+int32_t TFW_StrandPostMessage(TFW_Strand *strand, TFW_Message *msg)
+{
+    if (msg == NULL) {
+        TFW_LOGE_UTILS("the msg param is null.");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (strand == NULL || msg->handler == NULL) {
+        TFW_LOGE_UTILS("invalid strand or msg handler");
+        TFW_FreeMessage(msg);
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (TFW_AtomicLoad32(&strand->closed) != 0) {
+        TFW_FreeMessage(msg);
+        return TFW_ERROR_LOOPER_ERROR;
+    }
+    // 不以入队前队列为空作为调度条件：提交失败后scheduled已清零而积压仍在，需由后续投递重新调度；
+    // 与StrandRun中先清scheduled再检查inbox构成Dekker式检查，两者至少一方能看到对方的写入
+    InboxPush(strand, msg);
+    if (TFW_AtomicLoad32(&strand->scheduled) == 0) {
+        ScheduleStrand(strand);
+    }
+    return TFW_SUCCESS;
+}
+
+int32_t TFW_StrandPostMessageDelay(TFW_Strand *strand, TFW_Message *msg, uint64_t delayMillis)
+{
+    if (delayMillis == 0) {
+        return TFW_StrandPostMessage(strand, msg);
+    }
+    if (msg == NULL) {
+        TFW_LOGE_UTILS("the msg param is null.");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    const TFW_Looper *looper = TFW_GetLooper(TFW_LOOP_TYPE_DEFAULT);
+    TFW_Message *timer = (looper != NULL && strand != NULL) ? TFW_MallocMessage() : NULL;
+    if (timer == NULL) {
+        TFW_LOGE_UTILS("strand delayed post fail");
+        TFW_FreeMessage(msg);
+        return (looper == NULL || strand == NULL) ? TFW_ERROR_INVALID_PARAM : TFW_ERROR_MALLOC_ERR;
+    }
+    (void)TFW_AtomicInc32(&strand->refs);
+    timer->obj = strand;
+    timer->arg1 = (uint64_t)(uintptr_t)msg;
+    timer->handler = &g_strandTimerHandler;
+    timer->FreeMessage = StrandTimerFree;
+    // 失败时计时消息已被释放，连同msg与引用
+    return looper->PostMessageDelay(looper, timer, delayMillis);
+}
+
+bool TFW_StrandIsCurrent(const TFW_Strand *strand)
+{
+    return strand != NULL && g_currentStrand == strand;
+}
@@ -46,6 +46,7 @@ typedef struct {
 void* TFW_AtomicLoadPtr(TFW_AtomicPtr* atomic);
 void TFW_AtomicStorePtr(TFW_AtomicPtr* atomic, void* ptr);
 bool TFW_AtomicCompareAndSwapPtr(TFW_AtomicPtr* atomic, void* expected, void* desired);
+void* TFW_AtomicExchangePtr(TFW_AtomicPtr* atomic, void* ptr);
 
 // 内存屏障操作
 void TFW_MemoryBarrier(void);
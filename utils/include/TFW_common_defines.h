@@ -10,6 +10,16 @@
 #define TFW_UNUSED __attribute__((unused))
 #endif
 
+// 跨平台的线程局部存储标记宏
+// Cross-platform thread local storage marker macro
+#if defined(__cplusplus)
+#define TFW_THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+#define TFW_THREAD_LOCAL __declspec(thread)
+#else
+#define TFW_THREAD_LOCAL _Thread_local
+#endif
+
 // TODO:编译生成文件独立存放
 // Version information / 版本信息
 // Note: Update these values manually when releasing new versions
@@ -0,0 +1,67 @@
+#ifndef TFW_EXECUTOR_H
+#define TFW_EXECUTOR_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// 工作窃取线程池执行器
+// Work-stealing thread pool executor
+// ============================================================================
+
+// 默认执行器名称
+#define TFW_DEFAULT_EXECUTOR_NAME "TFW_Exec"
+
+// 单个执行器的最大工作线程数
+#define TFW_EXECUTOR_MAX_WORKERS 64U
+
+typedef struct TFW_Executor TFW_Executor;
+typedef struct TFW_ExecutorTask TFW_ExecutorTask;
+
+// 侵入式任务：调用者负责任务内存，Run执行完毕后执行器不再访问该任务
+struct TFW_ExecutorTask {
+    void (*Run)(TFW_ExecutorTask *task);
+    TFW_ExecutorTask *next;     // 执行器内部使用，注入队列链接
+};
+
+/**
+ * 创建执行器
+ * Create executor
+ * @param name 执行器名称，用于工作线程命名 / Executor name, used for worker thread names
+ * @param workerCnt 工作线程数，0表示读取配置项system.max_threads / Worker count, 0 reads system.max_threads
+ * @return 执行器指针，失败时返回NULL / Executor pointer, NULL on failure
+ */
+TFW_Executor *TFW_ExecutorCreate(const char *name, uint32_t workerCnt);
+
+/**
+ * 销毁执行器：等待已提交的任务全部执行完毕后回收工作线程
+ * Destroy executor: wait for all submitted tasks to finish, then join workers
+ * @param executor 执行器指针 / Executor pointer
+ */
+void TFW_ExecutorDestroy(TFW_Executor *executor);
+
+/**
+ * 提交任务，任务在任意工作线程上执行，不保证顺序
+ * Submit task, executed on any worker without ordering guarantees
+ * @param executor 执行器指针 / Executor pointer
+ * @param task 任务指针 / Task pointer
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+int32_t TFW_ExecutorSubmit(TFW_Executor *executor, TFW_ExecutorTask *task);
+
+/**
+ * 获取工作线程数
+ * Get worker count
+ * @param executor 执行器指针 / Executor pointer
+ * @return 工作线程数 / Worker count
+ */
+uint32_t TFW_ExecutorGetWorkerCount(const TFW_Executor *executor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TFW_EXECUTOR_H
@@ -0,0 +1,59 @@
+#ifndef TFW_HOUSEKEEPING_H
+#define TFW_HOUSEKEEPING_H
+
+#include <stdint.h>
+
+#include "TFW_message_loop.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// 空闲维护任务：仅在所挂载的looper空闲时执行，不与业务消息竞争
+// Idle housekeeping: jobs run only while the attached loopers are idle
+// ============================================================================
+
+#define TFW_HOUSEKEEPING_MAX_JOBS 16U
+#define TFW_HOUSEKEEPING_NAME_LEN 32U
+
+// 内置任务名称与最小执行间隔
+#define TFW_HOUSEKEEPING_LOG_FLUSH "log_flush"
+#define TFW_HOUSEKEEPING_LOG_FLUSH_INTERVAL_MS 1000U
+#define TFW_HOUSEKEEPING_MSG_POOL_TRIM "msg_pool_trim"
+#define TFW_HOUSEKEEPING_MSG_POOL_TRIM_INTERVAL_MS 10000U
+#define TFW_HOUSEKEEPING_MEM_TRIM "mem_trim"
+#define TFW_HOUSEKEEPING_MEM_TRIM_INTERVAL_MS 30000U
+
+typedef void (*TFW_HousekeepingFunc)(void *arg);
+
+// 初始化并注册内置任务（日志刷新、消息池收缩、malloc_trim），由TFW_LooperInit调用；可重复调用
+int32_t TFW_HousekeepingInit(void);
+
+// 注销内置任务，由TFW_LooperDeinit调用
+void TFW_HousekeepingDeinit(void);
+
+/**
+ * 注册维护任务：looper空闲且距上次执行超过intervalMs时执行，每次空闲至多执行一个任务
+ * Register a housekeeping job, run on an idle looper at most once per intervalMs
+ * @param name 任务名称，唯一 / Unique job name
+ * @param func 任务函数，在looper线程上执行，应尽快返回 / Job function, runs on a looper thread and should be short
+ * @param arg 任务参数 / Job argument
+ * @param intervalMs 最小执行间隔 / Minimum interval between runs
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+int32_t TFW_HousekeepingRegister(const char *name, TFW_HousekeepingFunc func, void *arg, uint32_t intervalMs);
+
+// 注销维护任务；任务正在执行时等待其结束，在任务内注销自身时不等待，本次执行结束后不再调度
+// Unregister a job, waiting for a running instance to finish
+int32_t TFW_HousekeepingUnregister(const char *name);
+
+// 在looper上挂载维护任务调度，多个looper挂载时同一任务不会并发执行
+// Attach the housekeeping scheduler to a looper as an idle handler
+int32_t TFW_HousekeepingAttach(const TFW_Looper *looper);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TFW_HOUSEKEEPING_H
@@ -67,6 +67,10 @@ int32_t TFW_LogInit(void);
 // Log system deinit
 int32_t TFW_LogDeinit(void);
 
+// 刷新已缓冲的日志输出；警告及以上等级的日志立即刷新，其余由空闲维护任务定期刷新
+// Flush buffered log output; warnings and above are flushed inline, the rest by idle housekeeping
+void TFW_LogFlush(void);
+
 
 // 日志实现函数声明（由log目录下的实现文件提供）
 // Log implementation function declaration (provided by the implementation file in the log directory)
@@ -0,0 +1,102 @@
+#ifndef TFW_LOOPER_GROUP_H
+#define TFW_LOOPER_GROUP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "TFW_message_loop.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Looper组：多个looper共用一个投递入口，按调用者提供的键哈希路由，同一键的消息始终由同一looper按序执行
+// Looper group: N loopers behind one post API, messages are routed by a caller-supplied key hash
+// ============================================================================
+
+#define TFW_LOOPER_GROUP_NAME_LEN 24U       // 组名长度上限(含结尾)，成员looper名为"组名-序号"
+#define TFW_LOOPER_GROUP_MAX_MEMBERS 64U
+
+typedef struct TFW_LooperGroup TFW_LooperGroup;
+
+typedef struct {
+    uint32_t memberCnt;         // 初始成员数，默认为TFW_ParallelConcurrency()
+    uint32_t maxMemberCnt;      // 可通过TFW_LooperGroupAddMember扩容到的上限，默认等于memberCnt
+    // 一致性哈希(jump consistent hash)：扩容时只有约1/N的键迁移，且只迁移到新成员；
+    // 关闭时按取模路由，路由更快但不支持扩容
+    bool consistentHash;
+    TFW_LooperAttr looperAttr;  // 成员looper的创建属性
+} TFW_LooperGroupAttr;
+
+typedef struct {
+    char name[TFW_LOOPER_GROUP_NAME_LEN + 8];   // 成员looper名称
+    uint64_t posted;            // 投递成功的消息数
+    uint64_t dispatched;        // 已执行的消息数
+    uint32_t curMsgSize;        // 当前排队的消息数
+    uint32_t peakMsgSize;       // 排队消息数峰值
+} TFW_LooperGroupMemberStats;
+
+void TFW_LooperGroupAttr_Init(TFW_LooperGroupAttr *attr);
+
+/**
+ * 创建looper组
+ * Create looper group
+ * @param name 组名，长度小于TFW_LOOPER_GROUP_NAME_LEN / Group name, shorter than TFW_LOOPER_GROUP_NAME_LEN
+ * @param attr 组属性，NULL使用默认值 / Group attributes, NULL for defaults
+ * @return 组指针，失败时返回NULL / Group pointer, NULL on failure
+ */
+TFW_LooperGroup *TFW_LooperGroupCreate(const char *name, const TFW_LooperGroupAttr *attr);
+
+// 销毁组及全部成员looper，尚未执行的消息被释放；不可在成员looper线程上调用
+// Destroy the group and its member loopers; must not be called on a member looper thread
+void TFW_LooperGroupDestroy(TFW_LooperGroup *group);
+
+/**
+ * 按键哈希投递消息：相同keyHash的即时消息按投递顺序执行，不同键分散到各成员并行执行
+ * Post by key hash; immediate messages with the same key run in post order
+ * @param group 组指针 / Group pointer
+ * @param keyHash 路由键的哈希值，如会话ID / Routing key hash, e.g. a session id
+ * @param msg 消息，接管所有权，失败时已被释放 / Message, ownership taken, freed on failure
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+int32_t TFW_LooperGroupPostMessage(TFW_LooperGroup *group, uint64_t keyHash, TFW_Message *msg);
+
+// 按键哈希延时投递，由该键当前所在的成员计时
+int32_t TFW_LooperGroupPostMessageDelay(TFW_LooperGroup *group, uint64_t keyHash, TFW_Message *msg,
+    uint64_t delayMillis);
+
+/**
+ * 获取键当前所在的成员looper，可用于RemoveMessage、TFW_LooperCancel等按looper的操作；
+ * 扩容后键可能迁移到新成员
+ * Get the member looper a key currently routes to; may change after TFW_LooperGroupAddMember
+ */
+const TFW_Looper *TFW_LooperGroupSelect(TFW_LooperGroup *group, uint64_t keyHash);
+
+/**
+ * 增加一个成员并重新分配键。迁移到新成员的键保持顺序：新成员先等待原成员执行完扩容前投递的
+ * 即时消息，再执行迁移后的消息；延时消息与不同优先级的消息不保证跨迁移的顺序
+ * Add a member and rebalance; moved keys stay ordered for immediate messages of the same priority
+ * @param group 组指针 / Group pointer
+ * @return TFW_SUCCESS 成功，TFW_ERROR_NOT_SUPPORTED 未启用一致性哈希或已达maxMemberCnt，负值表示错误
+ */
+int32_t TFW_LooperGroupAddMember(TFW_LooperGroup *group);
+
+// 当前成员数
+uint32_t TFW_LooperGroupMemberCount(TFW_LooperGroup *group);
+
+/**
+ * 获取各成员的队列深度与吞吐统计
+ * Get per-member queue depth and throughput statistics
+ * @param group 组指针 / Group pointer
+ * @param stats 输出数组 / Output array
+ * @param maxCnt 数组容量 / Array capacity
+ * @return 写入的成员数 / Number of members written
+ */
+uint32_t TFW_LooperGroupGetStats(TFW_LooperGroup *group, TFW_LooperGroupMemberStats *stats, uint32_t maxCnt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TFW_LOOPER_GROUP_H
@@ -56,6 +56,12 @@ char* TFW_Strdup(const char* src);
  */
 int32_t TFW_GetMemoryStats(uint64_t* total_allocated, uint64_t* total_freed, uint64_t* current_used);
 
+/**
+ * Return free heap memory to the system (malloc_trim on glibc), intended for idle housekeeping
+ * 将堆中空闲内存归还系统（glibc上为malloc_trim），供空闲维护任务调用
+ */
+void TFW_MemTrim(void);
+
 // 安全函数包装器
 int32_t TFW_Memset_S(void* dest, size_t destSize, int32_t c, size_t count);
 int32_t TFW_Memcpy_S(void* dest, size_t destSize, const void* src, size_t count);
@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "TFW_atomic.h"
+#include "TFW_executor.h"
 #include "TFW_list.h"
 #include "TFW_thread.h"
 
@@ -18,13 +20,25 @@ typedef struct TFW_Looper TFW_Looper;
 
 struct TFW_Looper {
     TFW_LooperContext *context;
-    bool dumpable;
-    void (*PostMessage)(const TFW_Looper *looper, TFW_Message *msg);
-    void (*PostMessageDelay)(const TFW_Looper *looper, TFW_Message *msg, uint64_t delayMillis);
+    bool dumpable;      // 是否记录事件追踪，请通过TFW_SetLooperDumpable修改
+    // 投递函数均接管msg的所有权，失败时消息已被释放；返回TFW_SUCCESS或错误码
+    int32_t (*PostMessage)(const TFW_Looper *looper, TFW_Message *msg);
+    int32_t (*PostMessageDelay)(const TFW_Looper *looper, TFW_Message *msg, uint64_t delayMillis);
+    // 批量投递count条即时消息，按数组顺序执行，仅一次入队操作和一次唤醒；有消息投递失败时返回最后一个错误码
+    int32_t (*PostMessageBatch)(const TFW_Looper *looper, TFW_Message **msgs, uint32_t count);
     void (*RemoveMessage)(const TFW_Looper *looper, const TFW_Handler *handler, int32_t what);
     // customFunc, when match, return 0
     void (*RemoveMessageCustom)(const TFW_Looper *looper, const TFW_Handler *handler,
         int32_t (*)(const TFW_Message*, void*), void *args);
+    // 是否存在尚未执行的(handler, what)消息
+    bool (*HasMessage)(const TFW_Looper *looper, const TFW_Handler *handler, int32_t what);
+    // 合并投递：已有相同(handler, what, key)的合并消息排队时，新消息替换其内容并沿用其排队位置
+    int32_t (*PostMessageCoalesced)(const TFW_Looper *looper, TFW_Message *msg, uint64_t key);
+    // 防抖投递：windowMs内再次投递相同(handler, what)的防抖消息时丢弃旧消息并重新计时
+    int32_t (*PostMessageDebounced)(const TFW_Looper *looper, TFW_Message *msg, uint64_t windowMs);
+    // 重复投递：periodMs后首次执行，之后每次执行完毕将同一消息重新放入定时堆，不重新分配；
+    // flags为TFW_LOOPER_REPEAT_*，通过TFW_LooperCancelRepeating或TFW_LooperCancel停止
+    int32_t (*PostMessageRepeating)(const TFW_Looper *looper, TFW_Message *msg, uint64_t periodMs, uint32_t flags);
 };
 
 struct TFW_Handler {
@@ -33,6 +47,57 @@ struct TFW_Handler {
     void (*HandleMessage)(TFW_Message *msg);
 };
 
+// looper内部使用的侵入式链接字段，调用者无需也不应访问
+// Intrusive link fields owned by the looper, callers must not touch them
+typedef struct {
+    TFW_ListNode node;      // 即时消息FIFO节点
+    TFW_ListNode indexNode; // (handler, what)索引桶节点
+    TFW_AtomicPtr next;     // 无锁投递队列/消息池链接
+    uint64_t seq;           // 投递序号，同一时刻的消息按序号保持FIFO
+    uint32_t heapIndex;     // 在延时消息最小堆中的下标
+    TFW_AtomicInt32 state;  // 批量分发中的状态，用于与移除操作竞争所有权
+    TFW_ExecutorTask task;  // 并发looper将消息作为任务提交到执行器
+    TFW_LooperContext *owner;   // 提交到执行器时记录所属looper，用于统计
+    uint64_t mergeKey;      // 合并投递的键
+    uint32_t mergeKind;     // 投递方式：普通、合并或防抖
+    uint64_t periodUs;      // 重复消息的周期，0表示一次性消息
+    uint32_t repeatFlags;
+    uint32_t repeatState;   // 重复消息所在位置：定时堆、执行中或已取消
+    uint32_t missedPeriods; // 本次执行前错过的周期数
+    uint64_t handle;        // 取消句柄，0表示未分配
+    TFW_ListNode handleNode;    // 句柄索引桶节点
+} TFW_MessageLink;
+
+// 消息取消句柄：全局递增分配、不复用，消息执行完毕或被移除后旧句柄不会误取消其他消息
+// Cancellation handle: allocated from a global sequence and never reused, so stale handles match nothing
+typedef uint64_t TFW_MessageHandle;
+#define TFW_MESSAGE_HANDLE_INVALID 0ULL
+
+// 重复投递方式
+#define TFW_LOOPER_REPEAT_FIXED_RATE 0x0U   // 按固定频率：第n次在首次到期后n个周期执行，执行超时错过的周期被跳过
+#define TFW_LOOPER_REPEAT_FIXED_DELAY 0x1U  // 按固定间隔：上次执行结束后一个周期再执行
+
+// 消息优先级：每个优先级在looper中拥有独立队列，按紧急、普通、空闲的顺序严格优先分发，
+// 低优先级队列连续被跳过达到预算次数后插入一次分发，避免饿死
+// Message priority: each class has its own queue, dispatched in strict priority order with an anti-starvation budget
+typedef enum {
+    TFW_MSG_PRIORITY_NORMAL = 0,    // 默认优先级
+    TFW_MSG_PRIORITY_URGENT,        // 延迟敏感的控制类消息
+    TFW_MSG_PRIORITY_IDLE,          // 后台批量任务
+    TFW_MSG_PRIORITY_MAX
+} TFW_MessagePriority;
+
+// 消息内联数据区：不超过TFW_MESSAGE_INLINE_SIZE的小对象可直接存放在消息中，随消息池复用，无需单独分配
+// Inline payload: small objects live inside the pooled message instead of a separate allocation
+#define TFW_MESSAGE_INLINE_SIZE 48U
+
+typedef union {
+    uint8_t bytes[TFW_MESSAGE_INLINE_SIZE];
+    uint64_t alignU64;
+    double alignDouble;
+    void *alignPtr;
+} TFW_MessageInline;
+
 struct TFW_Message {
     int32_t what;
     uint64_t arg1;
@@ -41,25 +106,93 @@ struct TFW_Message {
     void *obj;
     TFW_Handler *handler;
     void (*FreeMessage)(TFW_Message *msg);
+    TFW_MessagePriority priority;
+    TFW_MessageInline inlineData;
+    TFW_MessageLink link;
 };
 
 // 消息循环类型枚举
 typedef enum {
     TFW_LOOP_TYPE_DEFAULT,
     TFW_LOOP_TYPE_LOG,
+    TFW_LOOP_TYPE_CONCURRENT,   // 消息在工作窃取执行器上并发执行，不保证顺序
     TFW_LOOP_TYPE_MAX
 } TFW_LooperType;
 
 // 消息循环名称宏定义
 #define TFW_DEFAULT_LOOPER_NAME "TFW_Default_Lp"
 #define TFW_LOG_LOOPER_NAME "TFW_Log_Lp"
+#define TFW_CONCURRENT_LOOPER_NAME "TFW_Concur_Lp"
+
+// 队列已满时的投递策略
+typedef enum {
+    TFW_LOOPER_FULL_REJECT = 0,     // 拒绝新消息，返回TFW_ERROR_QUEUE_FULL
+    TFW_LOOPER_FULL_BLOCK,          // 阻塞等待空位，超时返回TFW_ERROR_TIMEOUT；在looper线程上投递时按拒绝处理
+    TFW_LOOPER_FULL_DROP_OLDEST,    // 丢弃最低优先级队列中最早到期的消息，新消息入队
+    TFW_LOOPER_FULL_DROP_NEWEST,    // 丢弃新消息，返回TFW_ERROR_MSG_DROPPED
+} TFW_LooperFullPolicy;
+
+// looper等待新消息的方式
+typedef enum {
+    TFW_LOOPER_BACKEND_COND = 0,    // 条件变量，所有平台可用
+    TFW_LOOPER_BACKEND_EPOLL,       // epoll + eventfd + timerfd，仅Linux，支持TFW_LooperAddFd
+} TFW_LooperBackend;
+
+// 描述符事件
+#define TFW_LOOPER_FD_READ 0x1U
+#define TFW_LOOPER_FD_WRITE 0x2U
+#define TFW_LOOPER_FD_ERROR 0x4U     // 仅作为就绪事件上报
+#define TFW_LOOPER_FD_HANGUP 0x8U    // 仅作为就绪事件上报
+
+// 描述符就绪消息：what为该值，arg1为fd，arg2为就绪事件，obj为looper内部使用
+#define TFW_LOOPER_WHAT_FD_EVENT (-1)
+
+// 消息循环属性
+typedef struct {
+    // 非NULL时到期消息提交到该执行器并发执行，不保证顺序；
+    // 即时消息直接提交，只有尚未到期的延时消息可被移除
+    TFW_Executor *executor;
+    // 容量：已投递但尚未执行完毕的消息数上限，0表示不限制
+    uint32_t capacity;
+    TFW_LooperFullPolicy fullPolicy;
+    uint32_t blockTimeoutMs;        // TFW_LOOPER_FULL_BLOCK的等待时间，0表示一直等待
+    TFW_LooperBackend backend;
+    // looper线程的调度策略、优先级、CPU亲和性和NUMA节点；name字段忽略，使用looper名称
+    TFW_ThreadAttr threadAttr;
+    // 延迟启动：首次投递消息或注册描述符时才创建looper线程
+    bool lazyStart;
+    // 定时器松弛：非紧急延时消息允许推迟至多timerSlackUs执行，相近的到期时间合并为一次唤醒；0表示准时唤醒
+    uint32_t timerSlackUs;
+    // 不创建looper线程，由调用者通过TFW_LooperRunOnce/TFW_LooperRun在自己的线程上驱动；threadAttr和lazyStart忽略
+    bool noThread;
+} TFW_LooperAttr;
+
+// 默认消息池上限：池中空闲消息超过该数量时直接释放
+#define TFW_MESSAGE_POOL_HIGH_WATER_DEFAULT 1024
 
+// 从消息池申请消息（已清零），池为空时从堆上分配
 TFW_Message *TFW_MallocMessage(void);
 
+// 释放消息：FreeMessage为NULL时归还消息池，否则调用FreeMessage
 void TFW_FreeMessage(TFW_Message *msg);
 
+// 将当前线程缓存的空闲消息归还全局池；任意线程退出时自动调用，长期空闲的线程可主动调用
+// Return this thread's cached messages to the global pool; runs automatically on thread exit
+void TFW_FlushMessagePoolLocal(void);
+
+// 设置消息池上限，0表示关闭消息池；其他线程的本地缓存在其下次申请消息时逐步耗尽
+void TFW_SetMessagePoolHighWater(uint32_t highWater);
+
+// 释放全局消息池中一半的空闲消息，由空闲维护任务定期调用
+void TFW_TrimMessagePool(void);
+
 TFW_Looper *TFW_CreateNewLooper(const char *name);
 
+void TFW_LooperAttr_Init(TFW_LooperAttr *attr);
+
+// attr为NULL时等同于TFW_CreateNewLooper
+TFW_Looper *TFW_CreateNewLooperWithAttr(const char *name, const TFW_LooperAttr *attr);
+
 void TFW_DestroyLooper(TFW_Looper *looper);
 
 void TFW_SetLooperDumpable(TFW_Looper *loop, bool dumpable);
@@ -68,6 +201,229 @@ TFW_Looper *TFW_GetLooper(TFW_LooperType type);
 
 void TFW_SetLooper(TFW_LooperType type, TFW_Looper *looper);
 
+// ============================================================================
+// 命名looper注册表
+// Named looper registry
+// ============================================================================
+
+/**
+ * 按名称获取looper并增加引用计数，不存在时以attr创建并注册
+ * Get a named looper and take a reference, creating it with attr if absent
+ * @param name looper名称，长度小于32 / Looper name, shorter than 32 characters
+ * @param attr 仅在创建时使用，可为NULL / Used only on creation, may be NULL
+ * @return looper，失败返回NULL；使用完毕后调用TFW_LooperRelease / Looper or NULL, release with TFW_LooperRelease
+ */
+TFW_Looper *TFW_LooperAcquire(const char *name, const TFW_LooperAttr *attr);
+
+// 按名称查找已注册的looper并增加引用计数，不存在时返回NULL；内置looper也可查找
+// Find a registered looper and take a reference, NULL if absent
+TFW_Looper *TFW_LooperFind(const char *name);
+
+// 释放引用，最后一个引用释放时注销并销毁looper；不可在该looper线程上释放最后一个引用
+// Drop a reference; the last release unregisters and destroys the looper
+void TFW_LooperRelease(TFW_Looper *looper);
+
+/**
+ * 停止重复消息；消息指针即句柄，调用后失效。可在该消息自身的HandleMessage中调用；
+ * 并发looper上已提交到执行器的一次仍会执行
+ * Stop a repeating message; the message pointer is the handle and becomes invalid afterwards
+ * @param looper 投递该消息的looper / Looper the message was posted to
+ * @param msg PostMessageRepeating投递的消息 / Message posted with PostMessageRepeating
+ * @return TFW_SUCCESS 成功，TFW_ERROR_NOT_FOUND 消息不是该looper上的重复消息
+ */
+int32_t TFW_LooperCancelRepeating(const TFW_Looper *looper, TFW_Message *msg);
+
+// 为消息分配取消句柄，须在投递前调用，之后以任一投递函数投递均可通过TFW_LooperCancel取消；
+// 重复调用分配新句柄，旧句柄失效
+// Allocate a cancellation handle for a message before posting it with any post function
+TFW_MessageHandle TFW_MessageGetHandle(TFW_Message *msg);
+
+/**
+ * 按句柄取消消息：仍在排队时从FIFO或定时堆中摘除（定时堆O(log n)），已移入分发批次但尚未执行时标记为取消；
+ * 重复消息正在执行时本次执行完毕后不再重新放入。可在任意线程调用，包括该looper自身的HandleMessage
+ * Cancel a message by handle; queued messages are unlinked, batched ones are cancelled before they run
+ * @param looper 投递该消息的looper / Looper the message was posted to
+ * @param handle TFW_MessageGetHandle返回的句柄 / Handle returned by TFW_MessageGetHandle
+ * @return TFW_SUCCESS 已取消，TFW_ERROR_NOT_FOUND 消息已开始执行、已执行完毕或已被取消
+ */
+int32_t TFW_LooperCancel(const TFW_Looper *looper, TFW_MessageHandle handle);
+
+// 重复消息本次执行前因上次执行超时而跳过的周期数，在HandleMessage中调用
+uint32_t TFW_MessageMissedPeriods(const TFW_Message *msg);
+
+// 当前存活的looper数量
+uint32_t TFW_GetLooperCount(void);
+
+// 修改定时器松弛，对之后的挂起生效；紧急优先级的消息始终准时唤醒
+// Change the timer slack; urgent messages always wake the looper on time
+int32_t TFW_LooperSetTimerSlack(const TFW_Looper *looper, uint32_t timerSlackUs);
+
+// ============================================================================
+// 运行时统计
+// Runtime statistics
+// ============================================================================
+
+// 直方图桶数：桶0为[0,1)us，桶i为[2^(i-1), 2^i)us，最后一个桶不设上限
+#define TFW_LOOPER_HIST_BUCKETS 24
+// 按handler分别统计的最大数量，超出部分合并到最后一项
+#define TFW_LOOPER_STATS_MAX_HANDLERS 16
+#define TFW_LOOPER_STATS_NAME_LEN 32
+#define TFW_LOOPER_STATS_OTHER_NAME "<other>"
+
+typedef struct {
+    char name[TFW_LOOPER_STATS_NAME_LEN];   // handler名称
+    uint64_t count;                         // 执行次数
+    uint64_t totalUs;                       // HandleMessage累计耗时
+    uint64_t maxUs;                         // HandleMessage最大耗时
+    uint64_t hist[TFW_LOOPER_HIST_BUCKETS]; // HandleMessage耗时直方图
+} TFW_LooperHandlerStats;
+
+typedef struct {
+    uint64_t posted;                        // 投递成功的消息数
+    uint64_t dispatched;                    // 已执行的消息数
+    uint64_t removed;                       // 被移除的消息数
+    uint64_t coalesced;                     // 被合并或防抖丢弃的消息数
+    uint64_t dropped;                       // 队列已满时丢弃的消息数
+    uint64_t rejected;                      // 队列已满时被拒绝的投递数
+    uint64_t blocked;                       // 队列已满时投递方阻塞等待的次数
+    uint64_t wakeups;                       // looper线程挂起后被唤醒或超时返回的次数
+    uint64_t missedPeriods;                 // 重复消息因执行超时而跳过的周期数
+    uint32_t curMsgSize;                    // 当前排队的消息数（含无锁队列中尚未转移的消息）
+    uint32_t laneMsgSize[TFW_MSG_PRIORITY_MAX]; // 各优先级队列中排队的消息数（不含正在分发的批次）
+    uint32_t peakMsgSize;                   // 排队消息数峰值
+    uint64_t delayMaxUs;                    // 调度延迟最大值
+    uint64_t delayHist[TFW_LOOPER_HIST_BUCKETS];    // 调度延迟（执行时刻 - msg->time）直方图
+    uint32_t handlerCnt;                    // handlers中的有效项数
+    TFW_LooperHandlerStats handlers[TFW_LOOPER_STATS_MAX_HANDLERS];
+} TFW_LooperStats;
+
+/**
+ * 获取looper运行时统计快照
+ * Get a snapshot of looper runtime statistics
+ * @param looper looper指针 / Looper pointer
+ * @param stats 输出统计信息 / Output statistics
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+int32_t TFW_LooperGetStats(const TFW_Looper *looper, TFW_LooperStats *stats);
+
+// ============================================================================
+// 事件追踪：每个looper一个定长二进制环形缓冲区，记录时只写入定长字段，不格式化字符串
+// Event trace: fixed-size binary ring per looper, recording writes raw fields only
+// ============================================================================
+
+// 环形缓冲区容量，写满后覆盖最早的事件
+#define TFW_LOOPER_TRACE_CAPACITY 256U
+
+typedef enum {
+    TFW_LOOPER_TRACE_POST = 0,      // 消息入队，time为投递时刻
+    TFW_LOOPER_TRACE_DISPATCH,      // 消息到期出队，进入分发批次或提交到执行器
+    TFW_LOOPER_TRACE_HANDLE_START,  // HandleMessage开始
+    TFW_LOOPER_TRACE_HANDLE_END,    // HandleMessage结束
+    TFW_LOOPER_TRACE_REMOVE,        // 消息被移除、丢弃或合并替换
+    TFW_LOOPER_TRACE_MAX
+} TFW_LooperTraceType;
+
+typedef struct {
+    int64_t timeUs;                 // 事件发生时刻（单调时钟）
+    TFW_LooperTraceType type;
+    int32_t what;
+    const TFW_Handler *handler;     // 仅用于比较和解码名称，handler可能已失效
+    uint64_t arg1;
+} TFW_LooperTraceEvent;
+
+/**
+ * 按发生顺序拷贝最近的追踪事件
+ * Copy the most recent trace events, oldest first
+ * @param looper looper指针 / Looper pointer
+ * @param events 输出缓冲区 / Output buffer
+ * @param maxCnt 缓冲区容量 / Buffer capacity
+ * @return 拷贝的事件数 / Number of events copied
+ */
+uint32_t TFW_LooperTraceSnapshot(const TFW_Looper *looper, TFW_LooperTraceEvent *events, uint32_t maxCnt);
+
+// 事件类型名称
+const char *TFW_LooperTraceTypeName(TFW_LooperTraceType type);
+
+// 解码最近的追踪事件并输出到日志，解码时读取handler名称，记录过的handler须仍然有效
+// Decode recent trace events to the log; recorded handlers must still be alive
+void TFW_LooperTraceDump(const TFW_Looper *looper);
+
+// 获取TFW_LooperInit创建的默认执行器
+TFW_Executor *TFW_GetDefaultExecutor(void);
+
+/**
+ * 在epoll后端的looper上监听描述符，就绪时在looper线程上向handler分发TFW_LOOPER_WHAT_FD_EVENT消息；
+ * 同一描述符在上一条就绪消息执行完毕前不会再次上报
+ * Watch fd on an epoll-backed looper; readiness is dispatched to handler as a message on the looper thread
+ * @param looper looper指针 / Looper pointer
+ * @param fd 描述符，调用者负责其生命周期 / File descriptor, owned by caller
+ * @param events TFW_LOOPER_FD_READ和/或TFW_LOOPER_FD_WRITE / TFW_LOOPER_FD_READ and/or TFW_LOOPER_FD_WRITE
+ * @param handler 接收就绪消息的handler / Handler receiving readiness messages
+ * @return TFW_SUCCESS 成功，条件变量后端返回TFW_ERROR_NOT_SUPPORTED / TFW_SUCCESS on success
+ */
+int32_t TFW_LooperAddFd(const TFW_Looper *looper, int32_t fd, uint32_t events, TFW_Handler *handler);
+
+// 停止监听描述符，并移除尚未开始执行的就绪消息
+// Stop watching fd and remove readiness messages that have not started yet
+int32_t TFW_LooperRemoveFd(const TFW_Looper *looper, int32_t fd);
+
+// ============================================================================
+// 空闲回调
+// Idle handlers
+// ============================================================================
+
+// 单个looper的空闲回调数量上限
+#define TFW_LOOPER_IDLE_HANDLER_MAX 8U
+// 空闲回调返回值：移除该回调
+#define TFW_LOOPER_IDLE_REMOVE (-1)
+// 空闲回调返回值：保留，looper下次由忙转闲时再调用
+#define TFW_LOOPER_IDLE_KEEP 0
+
+// 空闲回调，在looper线程上执行；返回正值表示looper持续空闲时在该毫秒数后再次调用
+typedef int32_t (*TFW_LooperIdleFunc)(void *arg);
+
+/**
+ * 添加空闲回调：looper没有到期消息、即将挂起时调用，每次由忙转闲调用一次
+ * Add idle handler, called on the looper thread before it parks with no due messages
+ * @param looper looper指针 / Looper pointer
+ * @param func 空闲回调 / Idle callback
+ * @param arg 回调参数 / Callback argument
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+int32_t TFW_LooperAddIdleHandler(const TFW_Looper *looper, TFW_LooperIdleFunc func, void *arg);
+
+// 移除(func, arg)空闲回调；回调可能正在looper线程上执行，回调内移除自身请返回TFW_LOOPER_IDLE_REMOVE
+// Remove idle handler; it may still be running on the looper thread when this returns
+int32_t TFW_LooperRemoveIdleHandler(const TFW_Looper *looper, TFW_LooperIdleFunc func, void *arg);
+
+// ============================================================================
+// 调用者线程驱动：以noThread属性创建的looper由调用者线程执行消息，省去每条消息一次的线程切换
+// Caller-driven loopers: a noThread looper runs its messages on the thread that drives it
+// ============================================================================
+
+/**
+ * 执行一轮：有到期消息时执行至多一个分发批次后返回，否则等待新消息或定时消息到期，至多timeoutMs；
+ * 同一时刻只能有一个线程驱动，不可在该looper的HandleMessage中嵌套调用
+ * Run one round: dispatch up to one batch of due messages, waiting at most timeoutMs if none are due
+ * @param looper 以noThread创建的looper / Looper created with noThread
+ * @param timeoutMs 等待时长，0表示不等待，负值表示一直等待 / Wait time, 0 to poll, negative to wait forever
+ * @return 执行的消息数，负值表示错误；非noThread looper返回TFW_ERROR_NOT_SUPPORTED
+ *         Number of messages dispatched, negative value on error
+ */
+int32_t TFW_LooperRunOnce(const TFW_Looper *looper, int32_t timeoutMs);
+
+/**
+ * 在调用线程上持续执行消息，直到TFW_LooperQuit或looper被其他线程销毁
+ * Drive the looper on the calling thread until TFW_LooperQuit or the looper is destroyed
+ * @return TFW_SUCCESS 因TFW_LooperQuit返回，TFW_ERROR_LOOPER_ERROR looper已销毁，负值表示错误
+ */
+int32_t TFW_LooperRun(const TFW_Looper *looper);
+
+// 使正在驱动的TFW_LooperRun或TFW_LooperRunOnce在当前批次执行完毕后返回，可在任意线程和HandleMessage中调用；
+// 未在驱动时对下一次调用生效
+// Make the running TFW_LooperRun or TFW_LooperRunOnce return after the current batch; callable from any thread
+int32_t TFW_LooperQuit(const TFW_Looper *looper);
+
 int32_t TFW_LooperInit(void);
 
 void TFW_LooperDeinit(void);
@@ -0,0 +1,75 @@
+#ifndef TFW_PARALLEL_H
+#define TFW_PARALLEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// 并行算法：在框架默认执行器上以fork-join方式执行，调用线程同时参与计算
+// Parallel algorithms: fork-join on the framework default executor, the caller participates
+// ============================================================================
+
+// 处理[begin, end)区间，slot为参与者编号，小于TFW_ParallelConcurrency()，同一slot不会并发执行
+typedef void (*TFW_ParallelForFunc)(size_t begin, size_t end, uint32_t slot, void *arg);
+
+// 将[begin, end)累积到acc
+typedef void (*TFW_ParallelReduceFunc)(size_t begin, size_t end, void *acc, void *arg);
+
+// 将partial合并到acc，须满足结合律与交换律
+typedef void (*TFW_ParallelCombineFunc)(void *acc, const void *partial, void *arg);
+
+// 与qsort比较函数兼容
+typedef int (*TFW_ParallelCompareFunc)(const void *lhs, const void *rhs);
+
+/**
+ * 获取并行参与者上限：默认执行器工作线程数加调用线程，执行器未初始化时为1
+ * Get the maximum number of participants: executor workers plus the caller, 1 without an executor
+ * @return 参与者上限 / Maximum participant count
+ */
+uint32_t TFW_ParallelConcurrency(void);
+
+/**
+ * 并行处理[begin, end)：剩余区间按参与者数自适应切分，单次不小于grain，全部完成后返回；
+ * 可在执行器工作线程上嵌套调用，调用线程始终参与计算，不会因工作线程耗尽而死锁
+ * Process [begin, end) in parallel with adaptive chunking, returns once every chunk is done
+ * @param begin 起始下标 / First index
+ * @param end 结束下标(不含) / One past the last index
+ * @param grain 最小切分粒度，0表示自动 / Minimum chunk size, 0 for automatic
+ * @param fn 区间处理函数 / Chunk function
+ * @param arg 用户参数 / User argument
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+int32_t TFW_ParallelFor(size_t begin, size_t end, size_t grain, TFW_ParallelForFunc fn, void *arg);
+
+/**
+ * 并行归约：每个参与者从result的初始值(单位元)开始累积，最后合并到result
+ * Parallel reduce: each participant starts from the identity held in result, partials are combined into it
+ * @param result 输入为单位元，输出为归约结果 / Identity on input, reduced value on output
+ * @param resultSize 结果大小(字节)，按字节复制 / Result size in bytes, copied bytewise
+ * @param reduceFn 区间累积函数 / Chunk accumulate function
+ * @param combineFn 合并函数 / Combine function
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+int32_t TFW_ParallelReduce(size_t begin, size_t end, size_t grain, void *result, size_t resultSize,
+    TFW_ParallelReduceFunc reduceFn, TFW_ParallelCombineFunc combineFn, void *arg);
+
+/**
+ * 并行归并排序：分段并行排序后逐层并行归并，需要与数组等大的临时内存，不保证稳定
+ * Parallel merge sort: sorts runs in parallel, then merges them level by level; not stable
+ * @param base 数组首地址 / Array base
+ * @param count 元素个数 / Element count
+ * @param size 元素大小(字节) / Element size in bytes
+ * @param cmp 比较函数，返回值语义同qsort / Comparator with qsort semantics
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+int32_t TFW_ParallelSort(void *base, size_t count, size_t size, TFW_ParallelCompareFunc cmp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TFW_PARALLEL_H
@@ -0,0 +1,67 @@
+#ifndef TFW_STRAND_H
+#define TFW_STRAND_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "TFW_executor.h"
+#include "TFW_message_loop.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Strand：不占用线程的串行消息队列，有待处理消息时才调度到执行器上按投递顺序逐条执行
+// Strand: a serial, ordered mailbox without its own thread, scheduled on an executor only while it has work
+// ============================================================================
+
+typedef struct TFW_Strand TFW_Strand;
+
+/**
+ * 创建strand
+ * Create strand
+ * @param name 名称，用于日志 / Name used in logs
+ * @param executor 执行消息的执行器，NULL表示框架默认执行器 / Executor to run on, NULL for the default executor
+ * @return strand指针，失败时返回NULL / Strand pointer, NULL on failure
+ */
+TFW_Strand *TFW_StrandCreate(const char *name, TFW_Executor *executor);
+
+/**
+ * 销毁strand：等待正在执行的消息结束，尚未执行的消息不再执行并被释放；
+ * 在该strand的消息中调用时不等待当前消息
+ * Destroy strand: waits for the running message, pending messages are freed without running
+ * @param strand strand指针 / Strand pointer
+ */
+void TFW_StrandDestroy(TFW_Strand *strand);
+
+/**
+ * 投递消息，同一strand上的消息按投递顺序逐条执行，不同strand之间并行
+ * Post message; messages on one strand run one at a time in post order
+ * @param strand strand指针 / Strand pointer
+ * @param msg 消息，接管所有权，失败时已被释放 / Message, ownership taken, freed on failure
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+int32_t TFW_StrandPostMessage(TFW_Strand *strand, TFW_Message *msg);
+
+/**
+ * 延时投递：由默认looper计时，到期后追加到strand队尾
+ * Delayed post: timed by the default looper, appended to the strand when due
+ * @param strand strand指针 / Strand pointer
+ * @param msg 消息，接管所有权，失败时已被释放 / Message, ownership taken, freed on failure
+ * @param delayMillis 延迟毫秒数 / Delay in milliseconds
+ * @return TFW_SUCCESS 成功，负值表示错误 / TFW_SUCCESS on success, negative value on error
+ */
+int32_t TFW_StrandPostMessageDelay(TFW_Strand *strand, TFW_Message *msg, uint64_t delayMillis);
+
+/**
+ * 当前线程是否正在执行该strand的消息
+ * Whether the calling thread is running a message of this strand
+ */
+bool TFW_StrandIsCurrent(const TFW_Strand *strand);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TFW_STRAND_H
@@ -13,14 +13,61 @@ typedef uintptr_t TFW_Mutex_t;
 typedef uintptr_t TFW_MutexAttr_t;
 typedef uintptr_t TFW_Cond_t;
 typedef uintptr_t TFW_Thread_t;
+typedef uintptr_t TFW_ThreadKey_t;
+
+// 线程调度策略
+typedef enum {
+    TFW_THREAD_SCHED_OTHER = 0,     // 分时调度，priority为nice值（-20~19，0表示不修改）
+    TFW_THREAD_SCHED_FIFO,          // 实时先进先出，priority为实时优先级（1~99），需要相应权限
+    TFW_THREAD_SCHED_RR             // 实时时间片轮转，priority同FIFO
+} TFW_ThreadSchedPolicy;
+
+// CPU亲和性掩码，最多支持TFW_THREAD_CPU_SET_SIZE个CPU
+#define TFW_THREAD_CPU_SET_SIZE 1024U
+#define TFW_THREAD_CPU_SET_WORDS (TFW_THREAD_CPU_SET_SIZE / 64U)
+
+typedef struct {
+    uint64_t bits[TFW_THREAD_CPU_SET_WORDS];
+} TFW_CpuSet;
+
+// 不指定NUMA节点
+#define TFW_THREAD_NUMA_NODE_ANY (-1)
 
 // 线程属性结构体
 typedef struct {
     const char *name;
     uint64_t stackSize;
     int32_t priority;
+    TFW_ThreadSchedPolicy policy;
+    TFW_CpuSet cpuSet;      // 允许运行的CPU，全零表示不限制
+    int32_t numaNode;       // 首选NUMA节点：未指定cpuSet时绑定到该节点的CPU，并优先从该节点分配内存
 } TFW_ThreadAttr;
 
+static inline void TFW_CpuSetZero(TFW_CpuSet *set) {
+    for (uint32_t i = 0; i < TFW_THREAD_CPU_SET_WORDS; i++) {
+        set->bits[i] = 0;
+    }
+}
+
+static inline void TFW_CpuSetAdd(TFW_CpuSet *set, uint32_t cpu) {
+    if (cpu < TFW_THREAD_CPU_SET_SIZE) {
+        set->bits[cpu / 64U] |= (1ULL << (cpu % 64U));
+    }
+}
+
+static inline bool TFW_CpuSetHas(const TFW_CpuSet *set, uint32_t cpu) {
+    return (cpu < TFW_THREAD_CPU_SET_SIZE) && ((set->bits[cpu / 64U] >> (cpu % 64U)) & 1ULL) != 0;
+}
+
+static inline bool TFW_CpuSetIsEmpty(const TFW_CpuSet *set) {
+    for (uint32_t i = 0; i < TFW_THREAD_CPU_SET_WORDS; i++) {
+        if (set->bits[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // 互斥锁类型
 typedef enum {
     TFW_MUTEX_NORMAL,
@@ -56,6 +103,11 @@ int32_t TFW_Thread_Join(TFW_Thread_t thread, void** value);
 int32_t TFW_Thread_SetName(TFW_Thread_t thread, const char* name);
 TFW_Thread_t TFW_Thread_GetSelf(void);
 
+// 线程局部键：线程退出时，若该线程设置的值非空则以该值调用destructor；键创建后不再销毁
+// Thread key: on thread exit, destructor is called with the thread's value when it is non-null
+int32_t TFW_ThreadKey_Create(TFW_ThreadKey_t* key, void (*destructor)(void*));
+int32_t TFW_ThreadKey_SetValue(TFW_ThreadKey_t key, void* value);
+
 // 内联检查函数
 static inline bool TFW_CheckMutexIsNull(const TFW_Mutex_t* mutex) {
     return (mutex == NULL) || ((void*)(*mutex) == NULL);
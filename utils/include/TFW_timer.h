@@ -18,6 +18,7 @@ extern "C" {
 #define TFW_TIME_SEC_TO_NS(sec) ((sec) * (1000 * 1000 * 1000))
 #define TFW_TIME_NS_TO_SEC(ns) ((ns) / (1000 * 1000 * 1000))
 #define TFW_TIME_NS_TO_MS(ns) ((ns) / (1000 * 1000))
+#define TFW_TIME_NS_TO_US(ns) ((ns) / 1000)
 #define TFW_TIME_MS_TO_NS(ms) ((ms) * (1000 * 1000))
 #define TFW_TIME_FORMAT_DEFAULT "%Y-%m-%d %H:%M:%S.mmm"
 
@@ -159,9 +159,12 @@ static TFW_UNUSED int32_t TFW_Log_GetFileName(const char *file_path, char *filen
  * 输出日志到控制台
  * Output log to console
  */
-static TFW_UNUSED void TFW_Log_OutputToStdout(const char *message) {
+static TFW_UNUSED void TFW_Log_OutputToStdout(const char *message, int32_t level) {
     printf("%s\n", message);
-    fflush(stdout);
+    // 低等级日志不在调用路径上刷新，由TFW_LogFlush批量刷新
+    if (level >= TFW_LOG_LEVEL_WARNING) {
+        fflush(stdout);
+    }
 }
 
 // TODO: 实现日志写入文件的功能
@@ -243,7 +246,7 @@ int32_t TFW_LOG_IMPL(int32_t module, int32_t level, const char *file,
     // 根据配置决定是否输出日志到标准输出
     // output log to console according to configuration
     if (g_logContext.logOutputMode  & (1 << TFW_LOG_OUTPUT_CONSOLE)) {
-        TFW_Log_OutputToStdout(logMessage);
+        TFW_Log_OutputToStdout(logMessage, level);
     }
 
     // 根据配置决定是否输出到文件
@@ -255,6 +258,10 @@ int32_t TFW_LOG_IMPL(int32_t module, int32_t level, const char *file,
     return TFW_SUCCESS;
 }
 
+void TFW_LogFlush(void) {
+    fflush(stdout);
+}
+
 static void TFW_LogOnConfigUpdate(TFW_ConfigKey key, const TFW_ConfigItem *item) {
     TFW_LOGI_UTILS("Log config updated: key=%d", key);
     switch (key) {
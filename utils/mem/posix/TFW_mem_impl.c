@@ -5,6 +5,11 @@
 #include <string.h>
 #include <pthread.h>
 #include <errno.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
 
 // ============================================================================
 // POSIX platform memory management implementation
@@ -111,6 +116,14 @@ int32_t TFW_GetMemoryStats(uint64_t* total_allocated, uint64_t* total_freed, uin
     return TFW_SUCCESS;
 }
 
+void TFW_MemTrim(void) {
+#if defined(__GLIBC__)
+    (void)malloc_trim(0);
+#elif defined(__APPLE__)
+    (void)malloc_zone_pressure_relief(NULL, 0);
+#endif
+}
+
 // 安全函数包装器实现
 int32_t TFW_Memset_S(void* dest, size_t destSize, int32_t c, size_t count) {
     if (dest == NULL || destSize == 0) {
@@ -2,6 +2,7 @@
 #include "../../include/TFW_log.h"
 #include "../../../interface/TFW_errorno.h"
 #include <windows.h>
+#include <malloc.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -153,6 +154,10 @@ int32_t TFW_GetMemoryStats(uint64_t* total_allocated, uint64_t* total_freed, uin
     return TFW_SUCCESS;
 }
 
+void TFW_MemTrim(void) {
+    (void)_heapmin();
+}
+
 // 安全函数包装器实现
 int32_t TFW_Memset_S(void* dest, size_t destSize, int32_t c, size_t count) {
     if (dest == NULL || destSize == 0) {
@@ -0,0 +1,241 @@
+#include "TFW_housekeeping.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "TFW_common_defines.h"
+#include "TFW_errorno.h"
+#include "TFW_log.h"
+#include "TFW_mem.h"
+#include "TFW_thread.h"
+#include "TFW_timer.h"
+#include "TFW_utils_log.h"
+
+#define HOUSEKEEPING_US_PER_MS 1000LL
+
+typedef struct {
+    char name[TFW_HOUSEKEEPING_NAME_LEN];
+    TFW_HousekeepingFunc func;
+    void *arg;
+    int64_t intervalUs;
+    int64_t lastRunUs;
+    bool used;
+    bool running;                 // 正在某个looper线程上执行，其他looper跳过该任务
+} TFW_HousekeepingJob;
+
+// 任务表与锁：挂载的空闲回调在looper销毁前都可能访问，锁初始化后不再销毁
+static TFW_HousekeepingJob g_hkJobs[TFW_HOUSEKEEPING_MAX_JOBS];
+static TFW_Mutex_t g_hkLock;
+static TFW_MutexAttr_t g_hkLockAttr;
+static TFW_Cond_t g_hkCond;       // 任务执行结束，通知等待注销的线程
+static bool g_hkInited = false;
+static TFW_THREAD_LOCAL const TFW_HousekeepingJob *g_hkCurrentJob = NULL;   // 当前线程正在执行的任务
+
+static void LogFlushJob(void *arg)
+{
+    (void)arg;
+    TFW_LogFlush();
+}
+
+static void MsgPoolTrimJob(void *arg)
+{
+    (void)arg;
+    TFW_TrimMessagePool();
+}
+
+static void MemTrimJob(void *arg)
+{
+    (void)arg;
+    TFW_MemTrim();
+}
+
+static TFW_HousekeepingJob *FindJobLocked(const char *name)
+{
+    for (uint32_t i = 0; i < TFW_HOUSEKEEPING_MAX_JOBS; i++) {
+        if (g_hkJobs[i].used && strcmp(g_hkJobs[i].name, name) == 0) {
+            return &g_hkJobs[i];
+        }
+    }
+    return NULL;
+}
+
+// 选出逾期最久且未在执行的任务
+static TFW_HousekeepingJob *PickDueJobLocked(int64_t now)
+{
+    TFW_HousekeepingJob *due = NULL;
+    int64_t dueAt = 0;
+    for (uint32_t i = 0; i < TFW_HOUSEKEEPING_MAX_JOBS; i++) {
+        TFW_HousekeepingJob *job = &g_hkJobs[i];
+        if (!job->used || job->running) {
+            continue;
+        }
+        int64_t at = job->lastRunUs + job->intervalUs;
+        if (at <= now && (due == NULL || at < dueAt)) {
+            due = job;
+            dueAt = at;
+        }
+    }
+    return due;
+}
+
+// 距下一个任务到期的毫秒数，无任务时返回TFW_LOOPER_IDLE_KEEP
+static int32_t NextDueMsLocked(int64_t now)
+{
+    bool found = false;
+    int64_t next = 0;
+    for (uint32_t i = 0; i < TFW_HOUSEKEEPING_MAX_JOBS; i++) {
+        const TFW_HousekeepingJob *job = &g_hkJobs[i];
+        if (!job->used || job->running) {
+            continue;
+        }
+        int64_t wait = job->lastRunUs + job->intervalUs - now;
+        next = (!found || wait < next) ? wait : next;
+        found = true;
+    }
+    if (!found) {
+        return TFW_LOOPER_IDLE_KEEP;
+    }
+    if (next <= 0) {
+        return 1;
+    }
+    next = (next + HOUSEKEEPING_US_PER_MS - 1) / HOUSEKEEPING_US_PER_MS;
+    return (next > INT32_MAX) ? INT32_MAX : (int32_t)next;
+}
+
+// 每次空闲至多执行一个到期任务，避免空闲回调长时间占用looper线程
+static int32_t HousekeepingOnIdle(void *arg)
+{
+    (void)arg;
+    int64_t now = (int64_t)TFW_GetTimestampUs();
+    (void)TFW_Mutex_Lock(&g_hkLock);
+    TFW_HousekeepingJob *job = PickDueJobLocked(now);
+    if (job != NULL) {
+        TFW_HousekeepingFunc func = job->func;
+        void *jobArg = job->arg;
+        job->running = true;
+        (void)TFW_Mutex_Unlock(&g_hkLock);
+        g_hkCurrentJob = job;
+        func(jobArg);
+        g_hkCurrentJob = NULL;
+        now = (int64_t)TFW_GetTimestampUs();
+        (void)TFW_Mutex_Lock(&g_hkLock);
+        job->running = false;
+        job->lastRunUs = now;
+        TFW_Cond_Broadcast(&g_hkCond);
+    }
+    int32_t next = NextDueMsLocked(now);
+    (void)TFW_Mutex_Unlock(&g_hkLock);
+    return next;
+}
+
+int32_t TFW_HousekeepingRegister(const char *name, TFW_HousekeepingFunc func, void *arg, uint32_t intervalMs)
+{
+    if (name == NULL || strlen(name) >= TFW_HOUSEKEEPING_NAME_LEN || func == NULL) {
+        TFW_LOGE_UTILS("invalid housekeeping job");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (!g_hkInited) {
+        return TFW_ERROR_NOT_INIT;
+    }
+    (void)TFW_Mutex_Lock(&g_hkLock);
+    if (FindJobLocked(name) != NULL) {
+        (void)TFW_Mutex_Unlock(&g_hkLock);
+        TFW_LOGE_UTILS("housekeeping job exists. name=%s", name);
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    for (uint32_t i = 0; i < TFW_HOUSEKEEPING_MAX_JOBS; i++) {
+        TFW_HousekeepingJob *job = &g_hkJobs[i];
+        // 在任务内注销自身的槽位直到本次执行结束才可复用
+        if (job->used || job->running) {
+            continue;
+        }
+        (void)TFW_Strcpy_S(job->name, sizeof(job->name), name);
+        job->func = func;
+        job->arg = arg;
+        job->intervalUs = (int64_t)intervalMs * HOUSEKEEPING_US_PER_MS;
+        job->lastRunUs = (int64_t)TFW_GetTimestampUs();
+        job->running = false;
+        job->used = true;
+        (void)TFW_Mutex_Unlock(&g_hkLock);
+        return TFW_SUCCESS;
+    }
+    (void)TFW_Mutex_Unlock(&g_hkLock);
+    TFW_LOGE_UTILS("housekeeping job full. name=%s", name);
+    return TFW_ERROR;
+}
+
+int32_t TFW_HousekeepingUnregister(const char *name)
+{
+    if (name == NULL) {
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (!g_hkInited) {
+        return TFW_ERROR_NOT_INIT;
+    }
+    (void)TFW_Mutex_Lock(&g_hkLock);
+    TFW_HousekeepingJob *job = FindJobLocked(name);
+    if (job == NULL) {
+        (void)TFW_Mutex_Unlock(&g_hkLock);
+        return TFW_ERROR_NOT_FOUND;
+    }
+    // 在任务内注销自身时等待会死锁，只标记注销，本次执行结束后不再调度
+    while (job->running && job != g_hkCurrentJob) {
+        (void)TFW_Cond_Wait(&g_hkCond, &g_hkLock, NULL);
+    }
+    job->used = false;
+    (void)TFW_Mutex_Unlock(&g_hkLock);
+    return TFW_SUCCESS;
+}
+
+int32_t TFW_HousekeepingAttach(const TFW_Looper *looper)
+{
+    if (!g_hkInited) {
+        return TFW_ERROR_NOT_INIT;
+    }
+    return TFW_LooperAddIdleHandler(looper, HousekeepingOnIdle, NULL);
+}
+
+// 内置任务已注册时视为成功，重复调用TFW_HousekeepingInit不会因任务已存在而失败
+static int32_t RegisterBuiltinJob(const char *name, TFW_HousekeepingFunc func, uint32_t intervalMs)
+{
+    (void)TFW_Mutex_Lock(&g_hkLock);
+    bool exists = (FindJobLocked(name) != NULL);
+    (void)TFW_Mutex_Unlock(&g_hkLock);
+    if (exists) {
+        return TFW_SUCCESS;
+    }
+    return TFW_HousekeepingRegister(name, func, NULL, intervalMs);
+}
+
+int32_t TFW_HousekeepingInit(void)
+{
+    if (!g_hkInited) {
+        TFW_MutexAttr_Init(&g_hkLockAttr);
+        TFW_Mutex_Init(&g_hkLock, &g_hkLockAttr);
+        TFW_Cond_Init(&g_hkCond);
+        g_hkInited = true;
+    }
+    int32_t ret = RegisterBuiltinJob(TFW_HOUSEKEEPING_LOG_FLUSH, LogFlushJob, TFW_HOUSEKEEPING_LOG_FLUSH_INTERVAL_MS);
+    if (ret == TFW_SUCCESS) {
+        ret = RegisterBuiltinJob(TFW_HOUSEKEEPING_MSG_POOL_TRIM, MsgPoolTrimJob,
+            TFW_HOUSEKEEPING_MSG_POOL_TRIM_INTERVAL_MS);
+    }
+    if (ret == TFW_SUCCESS) {
+        ret = RegisterBuiltinJob(TFW_HOUSEKEEPING_MEM_TRIM, MemTrimJob, TFW_HOUSEKEEPING_MEM_TRIM_INTERVAL_MS);
+    }
+    if (ret != TFW_SUCCESS) {
+        TFW_LOGE_UTILS("register builtin housekeeping fail. ret=%d", ret);
+        TFW_HousekeepingDeinit();
+    }
+    return ret;
+}
+
+void TFW_HousekeepingDeinit(void)
+{
+    if (!g_hkInited) {
+        return;
+    }
+    (void)TFW_HousekeepingUnregister(TFW_HOUSEKEEPING_LOG_FLUSH);
+    (void)TFW_HousekeepingUnregister(TFW_HOUSEKEEPING_MSG_POOL_TRIM);
+    (void)TFW_HousekeepingUnregister(TFW_HOUSEKEEPING_MEM_TRIM);
+}
@@ -0,0 +1,462 @@
+#include "TFW_looper_group.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "TFW_atomic.h"
+#include "TFW_errorno.h"
+#include "TFW_mem.h"
+#include "TFW_parallel.h"
+#include "TFW_thread.h"
+#include "TFW_utils_log.h"
+
+#define LOOPER_GROUP_MEMBER_NAME_LEN (TFW_LOOPER_GROUP_NAME_LEN + 8U)
+#define LOOPER_GROUP_MEMBER_PAD 64U
+#define LOOPER_GROUP_FENCE_HANDLER_NAME "TFW_LooperGroupFence"
+#define LOOPER_GROUP_JUMP_MUL 2862933555777941757ULL
+
+enum {
+    LOOPER_GROUP_WHAT_GATE = 0,     // 新成员上的闸门消息，等待原成员的屏障全部执行
+    LOOPER_GROUP_WHAT_BARRIER,      // 原成员上的屏障消息，排在扩容前投递的消息之后
+};
+
+// ============================================================================
+// 内部结构体定义
+// Internal structure definition
+// ============================================================================
+
+typedef struct {
+    TFW_Looper *looper;
+    // 在途投递数，按投递时成员数的奇偶分为两代，扩容时只等待旧一代归零
+    TFW_AtomicInt32 inflight[2];
+    char name[LOOPER_GROUP_MEMBER_NAME_LEN];
+    uint8_t pad[LOOPER_GROUP_MEMBER_PAD];   // 成员单独分配，填充使相邻成员的计数不共享缓存行
+} TFW_LooperGroupMember;
+
+struct TFW_LooperGroup {
+    TFW_AtomicInt32 memberCnt;      // 投递方只读，扩容时最后更新
+    TFW_AtomicInt32 draining;       // 扩容正在等待在途投递，投递方归零时需要唤醒
+    uint32_t maxMemberCnt;
+    bool consistentHash;
+    bool resizing;                  // 受lock保护，串行化扩容
+    TFW_LooperAttr looperAttr;
+    TFW_Mutex_t lock;
+    TFW_Cond_t cond;
+    char name[TFW_LOOPER_GROUP_NAME_LEN];
+    TFW_LooperGroupMember *members[TFW_LOOPER_GROUP_MAX_MEMBERS];
+};
+
+// 扩容时新成员等待原成员执行完扩容前投递的消息，引用由闸门消息和各屏障消息各持有一份
+typedef struct {
+    TFW_AtomicInt32 refs;
+    uint32_t pending;               // 尚未执行或释放的屏障数，受lock保护
+    TFW_Mutex_t lock;
+    TFW_Cond_t cond;
+} TFW_LooperGroupFence;
+
+// ============================================================================
+// 路由
+// Routing
+// ============================================================================
+
+// 调用者的键哈希可能只是递增的会话ID，先充分混合
+static uint64_t MixKey(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+// Jump consistent hash：成员数从n增加到n+1时只有约1/(n+1)的键迁移，且全部迁移到新成员
+static uint32_t JumpHash(uint64_t key, uint32_t buckets)
+{
+    int64_t bucket = -1;
+    int64_t next = 0;
+    while (next < (int64_t)buckets) {
+        bucket = next;
+        key = key * LOOPER_GROUP_JUMP_MUL + 1;
+        next = (int64_t)((double)(bucket + 1) * ((double)(1LL << 31) / (double)((key >> 33) + 1)));
+    }
+    return (uint32_t)bucket;
+}
+
+static uint32_t Route(const TFW_LooperGroup *group, uint64_t keyHash, uint32_t cnt)
+{
+    uint64_t key = MixKey(keyHash);
+    if (group->consistentHash) {
+        return JumpHash(key, cnt);
+    }
+    // 乘法取高位代替取模
+    return (uint32_t)(((key >> 32) * cnt) >> 32);
+}
+
+static void LeaveMember(TFW_LooperGroup *group, TFW_LooperGroupMember *member, uint32_t gen)
+{
+    if (TFW_AtomicDec32(&member->inflight[gen]) == 0 && TFW_AtomicLoad32(&group->draining) != 0) {
+        (void)TFW_Mutex_Lock(&group->lock);
+        TFW_Cond_Broadcast(&group->cond);
+        (void)TFW_Mutex_Unlock(&group->lock);
+    }
+}
+
+// 登记在途投递后再次确认成员数未变，与扩容的"先更新成员数再等待旧一代归零"构成Dekker式检查
+static TFW_LooperGroupMember *EnterMember(TFW_LooperGroup *group, uint64_t keyHash, uint32_t *gen)
+{
+    for (;;) {
+        uint32_t cnt = (uint32_t)TFW_AtomicLoad32(&group->memberCnt);
+        TFW_LooperGroupMember *member = group->members[Route(group, keyHash, cnt)];
+        (void)TFW_AtomicInc32(&member->inflight[cnt & 1U]);
+        if ((uint32_t)TFW_AtomicLoad32(&group->memberCnt) == cnt) {
+            *gen = cnt & 1U;
+            return member;
+        }
+        LeaveMember(group, member, cnt & 1U);
+    }
+}
+
+// ============================================================================
+// 扩容屏障
+// Rebalance fence
+// ============================================================================
+
+static void ReleaseFence(TFW_LooperGroupFence *fence)
+{
+    if (TFW_AtomicDec32(&fence->refs) != 0) {
+        return;
+    }
+    TFW_Cond_Destroy(&fence->cond);
+    TFW_Mutex_Destroy(&fence->lock);
+    TFW_Free(fence);
+}
+
+static void FenceArrive(TFW_LooperGroupFence *fence)
+{
+    (void)TFW_Mutex_Lock(&fence->lock);
+    if (--fence->pending == 0) {
+        TFW_Cond_Broadcast(&fence->cond);
+    }
+    (void)TFW_Mutex_Unlock(&fence->lock);
+}
+
+static void FenceHandle(TFW_Message *msg)
+{
+    if (msg->what != LOOPER_GROUP_WHAT_GATE) {
+        return;
+    }
+    TFW_LooperGroupFence *fence = (TFW_LooperGroupFence *)msg->obj;
+    (void)TFW_Mutex_Lock(&fence->lock);
+    while (fence->pending != 0) {
+        TFW_Cond_Wait(&fence->cond, &fence->lock, NULL);
+    }
+    (void)TFW_Mutex_Unlock(&fence->lock);
+}
+
+// 屏障执行完毕或未执行即被释放（如原成员已销毁）时都视为到达，避免闸门永久阻塞
+static void FenceFree(TFW_Message *msg)
+{
+    TFW_LooperGroupFence *fence = (TFW_LooperGroupFence *)msg->obj;
+    if (msg->what == LOOPER_GROUP_WHAT_BARRIER) {
+        FenceArrive(fence);
+    }
+    ReleaseFence(fence);
+    msg->FreeMessage = NULL;
+    TFW_FreeMessage(msg);
+}
+
+static TFW_Handler g_fenceHandler = { LOOPER_GROUP_FENCE_HANDLER_NAME, NULL, FenceHandle };
+
+static TFW_Message *MallocFenceMessage(TFW_LooperGroupFence *fence, int32_t what)
+{
+    TFW_Message *msg = TFW_MallocMessage();
+    if (msg == NULL) {
+        return NULL;
+    }
+    (void)TFW_AtomicInc32(&fence->refs);
+    msg->what = what;
+    msg->obj = fence;
+    msg->handler = &g_fenceHandler;
+    msg->FreeMessage = FenceFree;
+    return msg;
+}
+
+// 在新成员上投递紧急优先级的闸门消息，须在新成员对投递方可见之前完成
+static TFW_LooperGroupFence *PostGate(const TFW_Looper *looper, uint32_t barrierCnt)
+{
+    TFW_LooperGroupFence *fence = (TFW_LooperGroupFence *)TFW_Calloc(sizeof(TFW_LooperGroupFence));
+    if (fence == NULL) {
+        return NULL;
+    }
+    TFW_Mutex_Init(&fence->lock, NULL);
+    TFW_Cond_Init(&fence->cond);
+    TFW_AtomicStore32(&fence->refs, 1);
+    fence->pending = barrierCnt;
+    TFW_Message *gate = MallocFenceMessage(fence, LOOPER_GROUP_WHAT_GATE);
+    int32_t ret = TFW_ERROR_MALLOC_ERR;
+    if (gate != NULL) {
+        gate->priority = TFW_MSG_PRIORITY_URGENT;
+        // 成功时引用转交给闸门消息，失败时闸门消息已被释放
+        ret = looper->PostMessage(looper, gate);
+    }
+    if (ret != TFW_SUCCESS) {
+        ReleaseFence(fence);
+        return NULL;
+    }
+    return fence;
+}
+
+// 屏障投递失败时消息已被释放并计为到达
+static void PostBarriers(TFW_LooperGroup *group, TFW_LooperGroupFence *fence, uint32_t cnt)
+{
+    for (uint32_t i = 0; i < cnt; i++) {
+        TFW_Message *barrier = MallocFenceMessage(fence, LOOPER_GROUP_WHAT_BARRIER);
+        if (barrier == NULL) {
+            TFW_LOGE_UTILS("looper group barrier TFW_MallocMessage fail. name=%s", group->members[i]->name);
+            FenceArrive(fence);
+            continue;
+        }
+        const TFW_Looper *looper = group->members[i]->looper;
+        if (looper->PostMessage(looper, barrier) != TFW_SUCCESS) {
+            TFW_LOGW_UTILS("looper group barrier post fail, ordering of moved keys not guaranteed. name=%s",
+                group->members[i]->name);
+        }
+    }
+    ReleaseFence(fence);
+}
+
+// ============================================================================
+// 成员管理
+// Member management
+// ============================================================================
+
+static TFW_LooperGroupMember *CreateMember(TFW_LooperGroup *group, uint32_t index)
+{
+    TFW_LooperGroupMember *member = (TFW_LooperGroupMember *)TFW_Calloc(sizeof(TFW_LooperGroupMember));
+    if (member == NULL) {
+        TFW_LOGE_UTILS("looper group member TFW_Calloc fail");
+        return NULL;
+    }
+    (void)snprintf(member->name, sizeof(member->name), "%s-%u", group->name, index);
+    member->looper = TFW_CreateNewLooperWithAttr(member->name, &group->looperAttr);
+    if (member->looper == NULL) {
+        TFW_LOGE_UTILS("looper group create member fail. name=%s", member->name);
+        TFW_Free(member);
+        return NULL;
+    }
+    return member;
+}
+
+static void DestroyMember(TFW_LooperGroupMember *member)
+{
+    TFW_DestroyLooper(member->looper);
+    TFW_Free(member);
+}
+
+// ============================================================================
+// 公共接口实现
+// Public interface implementation
+// ============================================================================
+
+void TFW_LooperGroupAttr_Init(TFW_LooperGroupAttr *attr)
+{
+    if (attr == NULL) {
+        return;
+    }
+    (void)memset(attr, 0, sizeof(TFW_LooperGroupAttr));
+    attr->memberCnt = TFW_ParallelConcurrency();
+    if (attr->memberCnt > TFW_LOOPER_GROUP_MAX_MEMBERS) {
+        attr->memberCnt = TFW_LOOPER_GROUP_MAX_MEMBERS;
+    }
+    attr->consistentHash = false;
+    TFW_LooperAttr_Init(&attr->looperAttr);
+}
+
+TFW_LooperGroup *TFW_LooperGroupCreate(const char *name, const TFW_LooperGroupAttr *attr)
+{
+    TFW_LooperGroupAttr defaultAttr;
+    if (attr == NULL) {
+        TFW_LooperGroupAttr_Init(&defaultAttr);
+        attr = &defaultAttr;
+    }
+    uint32_t maxMemberCnt = (attr->maxMemberCnt == 0) ? attr->memberCnt : attr->maxMemberCnt;
+    if (name == NULL || strlen(name) >= TFW_LOOPER_GROUP_NAME_LEN || attr->memberCnt == 0 ||
+        maxMemberCnt < attr->memberCnt || maxMemberCnt > TFW_LOOPER_GROUP_MAX_MEMBERS) {
+        TFW_LOGE_UTILS("invalid looper group param");
+        return NULL;
+    }
+    // 执行器上的looper不保证顺序，无法作为组成员
+    if (attr->looperAttr.executor != NULL) {
+        TFW_LOGE_UTILS("looper group members cannot be executor-backed. name=%s", name);
+        return NULL;
+    }
+    TFW_LooperGroup *group = (TFW_LooperGroup *)TFW_Calloc(sizeof(TFW_LooperGroup));
+    if (group == NULL) {
+        TFW_LOGE_UTILS("looper group TFW_Calloc fail");
+        return NULL;
+    }
+    (void)snprintf(group->name, sizeof(group->name), "%s", name);
+    group->maxMemberCnt = maxMemberCnt;
+    group->consistentHash = attr->consistentHash;
+    group->looperAttr = attr->looperAttr;
+    for (uint32_t i = 0; i < attr->memberCnt; i++) {
+        group->members[i] = CreateMember(group, i);
+        if (group->members[i] == NULL) {
+            for (uint32_t j = 0; j < i; j++) {
+                DestroyMember(group->members[j]);
+            }
+            TFW_Free(group);
+            return NULL;
+        }
+    }
+    TFW_Mutex_Init(&group->lock, NULL);
+    TFW_Cond_Init(&group->cond);
+    TFW_AtomicStore32(&group->memberCnt, (int32_t)attr->memberCnt);
+    TFW_LOGI_UTILS("looper group created. name=%s, members=%u, consistentHash=%d",
+        group->name, attr->memberCnt, group->consistentHash);
+    return group;
+}
+
+void TFW_LooperGroupDestroy(TFW_LooperGroup *group)
+{
+    if (group == NULL) {
+        TFW_LOGE_UTILS("looper group is null");
+        return;
+    }
+    // 按序号销毁：扩容闸门所在的新成员序号最大，其等待的屏障随原成员一同释放
+    uint32_t cnt = (uint32_t)TFW_AtomicLoad32(&group->memberCnt);
+    for (uint32_t i = 0; i < cnt; i++) {
+        DestroyMember(group->members[i]);
+    }
+    TFW_Cond_Destroy(&group->cond);
+    TFW_Mutex_Destroy(&group->lock);
+    TFW_LOGI_UTILS("looper group destroyed. name=%s", group->name);
+    TFW_Free(group);
+}
+
+int32_t TFW_LooperGroupPostMessage(TFW_LooperGroup *group, uint64_t keyHash, TFW_Message *msg)
+{
+    return TFW_LooperGroupPostMessageDelay(group, keyHash, msg, 0);
+}
+
+int32_t TFW_LooperGroupPostMessageDelay(TFW_LooperGroup *group, uint64_t keyHash, TFW_Message *msg,
+    uint64_t delayMillis)
+{
+    if (msg == NULL) {
+        TFW_LOGE_UTILS("the msg param is null.");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (group == NULL) {
+        TFW_LOGE_UTILS("looper group is null");
+        TFW_FreeMessage(msg);
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    uint32_t gen = 0;
+    TFW_LooperGroupMember *member = EnterMember(group, keyHash, &gen);
+    const TFW_Looper *looper = member->looper;
+    int32_t ret = (delayMillis == 0) ? looper->PostMessage(looper, msg) :
+        looper->PostMessageDelay(looper, msg, delayMillis);
+    LeaveMember(group, member, gen);
+    return ret;
+}
+
+const TFW_Looper *TFW_LooperGroupSelect(TFW_LooperGroup *group, uint64_t keyHash)
+{
+    if (group == NULL) {
+        return NULL;
+    }
+    uint32_t cnt = (uint32_t)TFW_AtomicLoad32(&group->memberCnt);
+    return group->members[Route(group, keyHash, cnt)]->looper;
+}
+
+int32_t TFW_LooperGroupAddMember(TFW_LooperGroup *group)
+{
+    if (group == NULL) {
+        TFW_LOGE_UTILS("looper group is null");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    // 取模路由下扩容会使键在原成员之间迁移，闸门无法保证其顺序
+    if (!group->consistentHash) {
+        TFW_LOGE_UTILS("looper group rebalancing needs consistent hashing. name=%s", group->name);
+        return TFW_ERROR_NOT_SUPPORTED;
+    }
+    (void)TFW_Mutex_Lock(&group->lock);
+    while (group->resizing) {
+        TFW_Cond_Wait(&group->cond, &group->lock, NULL);
+    }
+    uint32_t cnt = (uint32_t)TFW_AtomicLoad32(&group->memberCnt);
+    if (cnt >= group->maxMemberCnt) {
+        (void)TFW_Mutex_Unlock(&group->lock);
+        TFW_LOGE_UTILS("looper group is full. name=%s, members=%u", group->name, cnt);
+        return TFW_ERROR_NOT_SUPPORTED;
+    }
+    group->resizing = true;
+    (void)TFW_Mutex_Unlock(&group->lock);
+
+    int32_t ret = TFW_SUCCESS;
+    TFW_LooperGroupFence *fence = NULL;
+    TFW_LooperGroupMember *member = CreateMember(group, cnt);
+    if (member == NULL) {
+        ret = TFW_ERROR_LOOPER_ERROR;
+    } else if ((fence = PostGate(member->looper, cnt)) == NULL) {
+        TFW_LOGE_UTILS("looper group post gate fail. name=%s", member->name);
+        DestroyMember(member);
+        ret = TFW_ERROR_LOOPER_ERROR;
+    } else {
+        group->members[cnt] = member;
+        TFW_AtomicStore32(&group->draining, 1);
+        TFW_AtomicStore32(&group->memberCnt, (int32_t)(cnt + 1));
+        // 等待仍按旧成员数路由的投递全部完成，之后投递到原成员的屏障排在这些消息之后
+        (void)TFW_Mutex_Lock(&group->lock);
+        for (uint32_t i = 0; i < cnt; i++) {
+            while (TFW_AtomicLoad32(&group->members[i]->inflight[cnt & 1U]) != 0) {
+                TFW_Cond_Wait(&group->cond, &group->lock, NULL);
+            }
+        }
+        (void)TFW_Mutex_Unlock(&group->lock);
+        TFW_AtomicStore32(&group->draining, 0);
+        PostBarriers(group, fence, cnt);
+        TFW_LOGI_UTILS("looper group member added. name=%s, members=%u", group->name, cnt + 1);
+    }
+
+    (void)TFW_Mutex_Lock(&group->lock);
+    group->resizing = false;
+    TFW_Cond_Broadcast(&group->cond);
+    (void)TFW_Mutex_Unlock(&group->lock);
+    return ret;
+}
+
+uint32_t TFW_LooperGroupMemberCount(TFW_LooperGroup *group)
+{
+    return (group == NULL) ? 0 : (uint32_t)TFW_AtomicLoad32(&group->memberCnt);
+}
+
+uint32_t TFW_LooperGroupGetStats(TFW_LooperGroup *group, TFW_LooperGroupMemberStats *stats, uint32_t maxCnt)
+{
+    if (group == NULL || stats == NULL) {
+        return 0;
+    }
+    uint32_t cnt = (uint32_t)TFW_AtomicLoad32(&group->memberCnt);
+    if (cnt > maxCnt) {
+        cnt = maxCnt;
+    }
+    TFW_LooperStats *looperStats = (TFW_LooperStats *)TFW_Malloc(sizeof(TFW_LooperStats));
+    if (looperStats == NULL) {
+        TFW_LOGE_UTILS("looper group stats TFW_Malloc fail");
+        return 0;
+    }
+    for (uint32_t i = 0; i < cnt; i++) {
+        TFW_LooperGroupMember *member = group->members[i];
+        (void)memset(&stats[i], 0, sizeof(TFW_LooperGroupMemberStats));
+        (void)snprintf(stats[i].name, sizeof(stats[i].name), "%s", member->name);
+        if (TFW_LooperGetStats(member->looper, looperStats) == TFW_SUCCESS) {
+            stats[i].posted = looperStats->posted;
+            stats[i].dispatched = looperStats->dispatched;
+            stats[i].curMsgSize = looperStats->curMsgSize;
+            stats[i].peakMsgSize = looperStats->peakMsgSize;
+        }
+    }
+    TFW_Free(looperStats);
+    return cnt;
+}
@@ -0,0 +1,199 @@
+#include "TFW_looper_stats_inner.h"
+
+#include <stdio.h>
+
+#include "TFW_mem.h"
+
+// 最后一个槽位固定用于汇总超出容量的handler
+#define HANDLER_SLOT_HASHED (TFW_LOOPER_STATS_MAX_HANDLERS - 1)
+
+static uint32_t HistBucket(int64_t us)
+{
+    uint32_t bucket = 0;
+    uint64_t value = (us > 0) ? (uint64_t)us : 0;
+    while (value != 0 && bucket < TFW_LOOPER_HIST_BUCKETS - 1) {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static void AtomicMax64(TFW_AtomicInt64 *atomic, int64_t value)
+{
+    int64_t cur = TFW_AtomicLoad64(atomic);
+    while (value > cur && !TFW_AtomicCompareAndSwap64(atomic, cur, value)) {
+        cur = TFW_AtomicLoad64(atomic);
+    }
+}
+
+static void AtomicMax32(TFW_AtomicInt32 *atomic, int32_t value)
+{
+    int32_t cur = TFW_AtomicLoad32(atomic);
+    while (value > cur && !TFW_AtomicCompareAndSwap32(atomic, cur, value)) {
+        cur = TFW_AtomicLoad32(atomic);
+    }
+}
+
+static TFW_LooperHandlerSlot *FindOtherSlot(TFW_LooperStatsCounter *counter)
+{
+    TFW_LooperHandlerSlot *other = &counter->handlers[HANDLER_SLOT_HASHED];
+    if (TFW_AtomicCompareAndSwap32(&other->ready, 0, -1)) {
+        (void)snprintf(other->name, sizeof(other->name), "%s", TFW_LOOPER_STATS_OTHER_NAME);
+        TFW_AtomicStore32(&other->ready, 1);
+    }
+    return other;
+}
+
+// 以handler指针哈希定位槽位并线性探测；表满时落入汇总槽位
+static TFW_LooperHandlerSlot *FindHandlerSlot(TFW_LooperStatsCounter *counter, const TFW_Handler *handler)
+{
+    if (handler == NULL) {
+        return FindOtherSlot(counter);
+    }
+    uint32_t start = (uint32_t)(((uintptr_t)handler >> 4) % HANDLER_SLOT_HASHED);
+    for (uint32_t i = 0; i < HANDLER_SLOT_HASHED; i++) {
+        TFW_LooperHandlerSlot *slot = &counter->handlers[(start + i) % HANDLER_SLOT_HASHED];
+        void *key = TFW_AtomicLoadPtr(&slot->handler);
+        if (key == (void *)handler) {
+            return slot;
+        }
+        if (key != NULL) {
+            continue;
+        }
+        if (TFW_AtomicCompareAndSwapPtr(&slot->handler, NULL, (void *)handler)) {
+            (void)snprintf(slot->name, sizeof(slot->name), "%s", (handler->name != NULL) ? handler->name : "null");
+            TFW_AtomicStore32(&slot->ready, 1);
+            return slot;
+        }
+        if (TFW_AtomicLoadPtr(&slot->handler) == (void *)handler) {
+            return slot;
+        }
+    }
+    return FindOtherSlot(counter);
+}
+
+bool TFW_LooperStatsOnPost(TFW_LooperStatsCounter *counter, uint32_t count, uint32_t capacity)
+{
+    int32_t depth = 0;
+    if (capacity == 0) {
+        depth = TFW_AtomicAdd32(&counter->depth, (int32_t)count);
+    } else {
+        int32_t cur = TFW_AtomicLoad32(&counter->depth);
+        for (;;) {
+            if ((int64_t)cur + count > (int64_t)capacity) {
+                return false;
+            }
+            if (TFW_AtomicCompareAndSwap32(&counter->depth, cur, cur + (int32_t)count)) {
+                break;
+            }
+            cur = TFW_AtomicLoad32(&counter->depth);
+        }
+        depth = cur + (int32_t)count;
+    }
+    (void)TFW_AtomicAdd64(&counter->posted, (int64_t)count);
+    AtomicMax32(&counter->peakDepth, depth);
+    return true;
+}
+
+void TFW_LooperStatsOnPostFailed(TFW_LooperStatsCounter *counter, uint32_t count)
+{
+    (void)TFW_AtomicSub64(&counter->posted, (int64_t)count);
+    (void)TFW_AtomicSub32(&counter->depth, (int32_t)count);
+}
+
+void TFW_LooperStatsOnDrop(TFW_LooperStatsCounter *counter, bool queued)
+{
+    (void)TFW_AtomicInc64(&counter->dropped);
+    if (queued) {
+        (void)TFW_AtomicDec32(&counter->depth);
+    }
+}
+
+void TFW_LooperStatsOnReject(TFW_LooperStatsCounter *counter)
+{
+    (void)TFW_AtomicInc64(&counter->rejected);
+}
+
+void TFW_LooperStatsOnBlock(TFW_LooperStatsCounter *counter)
+{
+    (void)TFW_AtomicInc64(&counter->blocked);
+}
+
+void TFW_LooperStatsOnWakeup(TFW_LooperStatsCounter *counter)
+{
+    (void)TFW_AtomicInc64(&counter->wakeups);
+}
+
+void TFW_LooperStatsOnMissed(TFW_LooperStatsCounter *counter, uint32_t count)
+{
+    (void)TFW_AtomicAdd64(&counter->missedPeriods, (int64_t)count);
+}
+
+void TFW_LooperStatsOnRemove(TFW_LooperStatsCounter *counter, uint32_t count)
+{
+    (void)TFW_AtomicAdd64(&counter->removed, (int64_t)count);
+    (void)TFW_AtomicSub32(&counter->depth, (int32_t)count);
+}
+
+void TFW_LooperStatsOnCoalesce(TFW_LooperStatsCounter *counter)
+{
+    (void)TFW_AtomicInc64(&counter->coalesced);
+    (void)TFW_AtomicDec32(&counter->depth);
+}
+
+void TFW_LooperStatsOnDispatch(TFW_LooperStatsCounter *counter, const TFW_Handler *handler,
+    int64_t delayUs, int64_t handleUs)
+{
+    (void)TFW_AtomicInc64(&counter->dispatched);
+    (void)TFW_AtomicDec32(&counter->depth);
+    if (delayUs < 0) {
+        delayUs = 0;
+    }
+    if (handleUs < 0) {
+        handleUs = 0;
+    }
+    (void)TFW_AtomicInc64(&counter->delayHist[HistBucket(delayUs)]);
+    AtomicMax64(&counter->delayMaxUs, delayUs);
+
+    TFW_LooperHandlerSlot *slot = FindHandlerSlot(counter, handler);
+    (void)TFW_AtomicInc64(&slot->count);
+    (void)TFW_AtomicAdd64(&slot->totalUs, handleUs);
+    (void)TFW_AtomicInc64(&slot->hist[HistBucket(handleUs)]);
+    AtomicMax64(&slot->maxUs, handleUs);
+}
+
+void TFW_LooperStatsSnapshot(TFW_LooperStatsCounter *counter, TFW_LooperStats *stats)
+{
+    (void)TFW_Memset_S(stats, sizeof(TFW_LooperStats), 0, sizeof(TFW_LooperStats));
+    stats->posted = (uint64_t)TFW_AtomicLoad64(&counter->posted);
+    stats->dispatched = (uint64_t)TFW_AtomicLoad64(&counter->dispatched);
+    stats->removed = (uint64_t)TFW_AtomicLoad64(&counter->removed);
+    stats->coalesced = (uint64_t)TFW_AtomicLoad64(&counter->coalesced);
+    stats->dropped = (uint64_t)TFW_AtomicLoad64(&counter->dropped);
+    stats->rejected = (uint64_t)TFW_AtomicLoad64(&counter->rejected);
+    stats->blocked = (uint64_t)TFW_AtomicLoad64(&counter->blocked);
+    stats->wakeups = (uint64_t)TFW_AtomicLoad64(&counter->wakeups);
+    stats->missedPeriods = (uint64_t)TFW_AtomicLoad64(&counter->missedPeriods);
+    int32_t depth = TFW_AtomicLoad32(&counter->depth);
+    stats->curMsgSize = (depth > 0) ? (uint32_t)depth : 0;
+    stats->peakMsgSize = (uint32_t)TFW_AtomicLoad32(&counter->peakDepth);
+    stats->delayMaxUs = (uint64_t)TFW_AtomicLoad64(&counter->delayMaxUs);
+    for (uint32_t i = 0; i < TFW_LOOPER_HIST_BUCKETS; i++) {
+        stats->delayHist[i] = (uint64_t)TFW_AtomicLoad64(&counter->delayHist[i]);
+    }
+
+    for (uint32_t i = 0; i < TFW_LOOPER_STATS_MAX_HANDLERS; i++) {
+        TFW_LooperHandlerSlot *slot = &counter->handlers[i];
+        if (TFW_AtomicLoad32(&slot->ready) != 1) {
+            continue;
+        }
+        TFW_LooperHandlerStats *out = &stats->handlers[stats->handlerCnt++];
+        (void)snprintf(out->name, sizeof(out->name), "%s", slot->name);
+        out->count = (uint64_t)TFW_AtomicLoad64(&slot->count);
+        out->totalUs = (uint64_t)TFW_AtomicLoad64(&slot->totalUs);
+        out->maxUs = (uint64_t)TFW_AtomicLoad64(&slot->maxUs);
+        for (uint32_t j = 0; j < TFW_LOOPER_HIST_BUCKETS; j++) {
+            out->hist[j] = (uint64_t)TFW_AtomicLoad64(&slot->hist[j]);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#include "TFW_looper_trace_inner.h"
+
+#define TRACE_MASK ((int64_t)TFW_LOOPER_TRACE_CAPACITY - 1)
+#define TRACE_TYPE_SHIFT 32
+
+void TFW_LooperTraceInit(TFW_LooperTraceRing *ring, bool enabled)
+{
+    TFW_AtomicStore64(&ring->head, 0);
+    for (uint32_t i = 0; i < TFW_LOOPER_TRACE_CAPACITY; i++) {
+        TFW_AtomicStore64(&ring->slots[i].seq, 0);
+    }
+    TFW_AtomicStore32(&ring->enabled, enabled ? 1 : 0);
+}
+
+void TFW_LooperTraceSetEnabled(TFW_LooperTraceRing *ring, bool enabled)
+{
+    TFW_AtomicStore32(&ring->enabled, enabled ? 1 : 0);
+}
+
+void TFW_LooperTraceRecord(TFW_LooperTraceRing *ring, TFW_LooperTraceType type, const TFW_Message *msg,
+    int64_t timeUs)
+{
+    if (TFW_AtomicLoad32(&ring->enabled) == 0) {
+        return;
+    }
+    int64_t index = TFW_AtomicInc64(&ring->head) - 1;
+    TFW_LooperTraceSlot *slot = &ring->slots[index & TRACE_MASK];
+    TFW_AtomicStore64(&slot->seq, 0);
+    TFW_AtomicStore64(&slot->timeUs, timeUs);
+    TFW_AtomicStore64(&slot->arg1, (int64_t)msg->arg1);
+    TFW_AtomicStore64(&slot->typeWhat, (int64_t)(((uint64_t)type << TRACE_TYPE_SHIFT) | (uint32_t)msg->what));
+    TFW_AtomicStorePtr(&slot->handler, (void *)msg->handler);
+    TFW_AtomicStore64(&slot->seq, index + 1);
+}
+
+uint32_t TFW_LooperTraceCopy(TFW_LooperTraceRing *ring, TFW_LooperTraceEvent *events, uint32_t maxCnt)
+{
+    int64_t head = TFW_AtomicLoad64(&ring->head);
+    int64_t begin = head - (int64_t)TFW_LOOPER_TRACE_CAPACITY;
+    if (begin < 0) {
+        begin = 0;
+    }
+    if (head - begin > (int64_t)maxCnt) {
+        begin = head - (int64_t)maxCnt;
+    }
+    uint32_t count = 0;
+    for (int64_t index = begin; index < head; index++) {
+        TFW_LooperTraceSlot *slot = &ring->slots[index & TRACE_MASK];
+        // 尚未写完或已被更新的写入覆盖时跳过
+        if (TFW_AtomicLoad64(&slot->seq) != index + 1) {
+            continue;
+        }
+        TFW_LooperTraceEvent *event = &events[count];
+        uint64_t typeWhat = (uint64_t)TFW_AtomicLoad64(&slot->typeWhat);
+        event->timeUs = TFW_AtomicLoad64(&slot->timeUs);
+        event->arg1 = (uint64_t)TFW_AtomicLoad64(&slot->arg1);
+        event->type = (TFW_LooperTraceType)(typeWhat >> TRACE_TYPE_SHIFT);
+        event->what = (int32_t)(uint32_t)typeWhat;
+        event->handler = (const TFW_Handler *)TFW_AtomicLoadPtr(&slot->handler);
+        if (TFW_AtomicLoad64(&slot->seq) != index + 1) {
+            continue;
+        }
+        count++;
+    }
+    return count;
+}
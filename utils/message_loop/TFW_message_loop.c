@@ -1,9 +1,17 @@
 #include "TFW_message_loop.h"
 
+#include <stddef.h>
 #include <string.h>
 #include <unistd.h>
 
+#include "TFW_atomic.h"
+#include "TFW_common_defines.h"
+#include "TFW_executor.h"
+#include "TFW_housekeeping.h"
 #include "TFW_list.h"
+#include "TFW_looper_poller.h"
+#include "TFW_looper_stats_inner.h"
+#include "TFW_looper_trace_inner.h"
 #include "TFW_mem.h"
 #include "TFW_thread.h"
 #include "TFW_timer.h"
@@ -11,27 +19,130 @@
 
 #define LOOP_NAME_LEN 32
 #define TIME_THOUSANDS_MULTIPLIER 1000LL
-#define MAX_LOOPER_CNT 30U
 #define MAX_LOOPER_PRINT_CNT 64
+#define TIMER_HEAP_INIT_CAP 64U
+#define TIMER_HEAP_INVALID_INDEX UINT32_MAX
+#define LOOPER_DISPATCH_BATCH_MAX 64U
+#define LOOPER_LANE_STARVE_BUDGET 16U    // 低优先级队列有到期消息时最多连续被跳过的次数
+#define MSG_INDEX_INIT_BUCKETS 64U       // 须为2的幂
+#define MSG_INDEX_LOAD_FACTOR 2U         // 平均每桶消息数超过该值时扩容
+#define REGISTRY_INIT_BUCKETS 16U        // 须为2的幂
+#define REGISTRY_LOAD_FACTOR 2U
+
+// 批量分发中消息的状态
+enum {
+    MESSAGE_STATE_QUEUED = 0,   // 已移入分发批次，等待执行
+    MESSAGE_STATE_INSPECTING,   // 移除操作正在匹配
+    MESSAGE_STATE_DISPATCHING,  // looper线程已认领并执行
+    MESSAGE_STATE_CANCELLED,    // 已被移除，不再执行
+};
+
+// 重复消息的位置，在lock下修改
+enum {
+    MESSAGE_REPEAT_NONE = 0,    // 一次性消息
+    MESSAGE_REPEAT_ARMED,       // 在FIFO或定时堆中等待到期
+    MESSAGE_REPEAT_RUNNING,     // 已取出分发，执行完毕后重新放入定时堆
+    MESSAGE_REPEAT_CANCELLED,   // 执行期间被取消，执行完毕后释放
+};
+
+enum {
+    MESSAGE_MERGE_NONE = 0,     // 普通投递
+    MESSAGE_MERGE_COALESCED,    // 合并投递，按(handler, what, key)替换
+    MESSAGE_MERGE_DEBOUNCED,    // 防抖投递，按(handler, what)丢弃旧消息并重新计时
+};
 
+// 单个优先级的消息队列
 typedef struct {
-    TFW_Message *msg;
-    TFW_ListNode node;
-} TFW_MessageNode;
+    TFW_ListNode msgHead;         // 即时消息FIFO，投递时已到期的消息直接追加到尾部
+    TFW_Message **timerHeap;      // 延时消息最小堆，按(time, seq)排序
+    uint32_t timerHeapSize;
+    uint32_t timerHeapCap;
+    uint32_t msgSize;
+    uint32_t skipped;             // 有到期消息但让位于更高优先级队列的连续次数
+} TFW_LooperLane;
+
+typedef struct {
+    TFW_LooperIdleFunc func;
+    void *arg;
+    int64_t deadline;             // 持续空闲时再次调用的时刻，TFW_LOOPER_POLL_FOREVER表示等待下次由忙转闲
+} TFW_LooperIdleEntry;
+
+// 分发顺序：紧急、普通、空闲
+static const TFW_MessagePriority g_laneOrder[TFW_MSG_PRIORITY_MAX] = {
+    TFW_MSG_PRIORITY_URGENT, TFW_MSG_PRIORITY_NORMAL, TFW_MSG_PRIORITY_IDLE
+};
 
 struct TFW_LooperContext {
-    TFW_ListNode msgHead;
+    TFW_LooperLane lanes[TFW_MSG_PRIORITY_MAX];  // 按TFW_MessagePriority下标
+    uint64_t postSeq;
+    // 零延时消息的无锁多生产者单消费者队列（Vyukov侵入式）
+    // 生产者只做一次原子交换；出队统一在持有lock时进行，保证单消费者语义
+    TFW_AtomicPtr mpscHead;       // 生产者端：最近入队的节点
+    TFW_Message *mpscTail;        // 消费者端：下一个待出队的节点
+    TFW_Message mpscStub;
+    TFW_AtomicInt32 parked;       // looper线程是否正在cond上等待，生产者仅在其为1时唤醒
+    int64_t parkDeadline;         // 挂起的唤醒时刻，新延时消息不早于该时刻到期时无需唤醒
+    int64_t timerSlackUs;         // 非紧急延时消息允许推迟的时长
     char name[LOOP_NAME_LEN];
     volatile unsigned char stop; // destroys looper, stop =1, and running =0
     volatile unsigned char running;
-    TFW_Message *currentMsg;
-    uint32_t msgSize;
+    // 当前分发批次：持有lock时填充，执行时不加锁；消息在下一次加锁时统一释放
+    TFW_Message *batch[LOOPER_DISPATCH_BATCH_MAX];
+    uint32_t batchCount;
+    TFW_Executor *executor;       // 非NULL时到期消息提交到执行器并发执行
+    // 已提交到执行器但尚未执行完毕的消息数，归零只在lock下发生，TFW_DestroyLooper等待其归零
+    TFW_AtomicInt32 executorTasks;
+    uint32_t capacity;            // 未执行完毕的消息数上限，0表示不限制，计数为stats.depth
+    TFW_LooperFullPolicy fullPolicy;
+    uint32_t blockTimeoutMs;
+    TFW_AtomicInt32 notFullWaiters;   // 因队列已满阻塞在condNotFull上的投递线程数
+    uint64_t threadId;            // looper线程ID，用于避免在looper线程上阻塞投递
+    TFW_LooperStatsCounter stats; // 运行时统计
+    TFW_LooperTraceRing trace;    // 事件追踪，由looper->dumpable控制开关
+    // (handler, what)二级索引：FIFO与定时堆中的消息按键散列到桶链表，定向移除与查询平均O(1)
+    TFW_ListNode *indexBuckets;
+    uint32_t indexBucketCnt;
+    uint32_t msgSize;             // 所有优先级队列中的消息总数
+    // 取消句柄索引：分配了句柄且仍可取消的消息（排队中、分发批次中、执行中的重复消息）按句柄散列
+    TFW_ListNode *handleBuckets;
+    uint32_t handleBucketCnt;
+    uint32_t handleCnt;
+    // 空闲回调：looper线程由忙转闲时调用一次，之后按回调请求的间隔在持续空闲期间再次调用
+    TFW_LooperIdleEntry idleHandlers[TFW_LOOPER_IDLE_HANDLER_MAX];
+    uint32_t idleHandlerCnt;
+    bool idlePending;             // 上次执行空闲回调后是否分发过消息
+    int64_t idleDeadline;         // 持续空闲时再次执行空闲回调的时刻，TFW_LOOPER_POLL_FOREVER表示不再执行
     TFW_Mutex_t lock;
     TFW_MutexAttr_t attr;
     TFW_Cond_t cond;          // 用于通知有新消息
     TFW_Cond_t condRunning;   // 用于通知looper状态变化
+    TFW_Cond_t condNotFull;   // 用于通知阻塞的投递线程队列出现空位
+    TFW_LooperPoller *poller; // epoll后端，NULL表示使用条件变量等待
+    TFW_Mutex_t fdLock;       // 保护fdEntries和描述符的重新启用，加锁顺序在lock之后
+    TFW_ListNode fdEntries;
+    TFW_AtomicInt32 started;      // 线程已创建；延迟启动的looper在首次投递时创建线程
+    bool noThread;                // 不创建线程，由调用者通过TFW_LooperRunOnce驱动
+    bool driving;                 // 调用者线程正在TFW_LooperRunOnce中驱动，受lock保护
+    TFW_AtomicInt32 quit;         // TFW_LooperQuit请求TFW_LooperRun返回
+    TFW_ThreadAttr threadAttr;    // 延迟启动时使用的线程属性
+    TFW_Looper *looper;
+    // 命名注册表：以下字段均在g_registryLock下访问
+    TFW_ListNode regNode;
+    uint32_t refs;
+    bool registered;
 };
 
+// 已注册的描述符；引用计数由注册本身和在途的就绪消息（至多一条）持有，均在fdLock下修改
+typedef struct {
+    TFW_ListNode node;
+    int32_t fd;
+    uint32_t events;
+    TFW_Handler *handler;
+    TFW_LooperContext *context;
+    uint32_t refs;
+    bool removed;
+} TFW_LooperFdEntry;
+
 // Looper配置项结构体
 struct LooperConfigItem {
     TFW_LooperType type;
@@ -41,9 +152,9 @@ struct LooperConfigItem {
 // 全局Looper配置数组
 static struct LooperConfigItem g_looperConfig[TFW_LOOP_TYPE_MAX] = {0}; // 只为有效枚举值分配空间
 
-static uint32_t g_looperCnt = 0;
-static int8_t g_isNeedDestroy = 0;
-static int8_t g_isThreadStarted = 0;
+static TFW_Executor *g_defaultExecutor = NULL;
+static TFW_AtomicInt32 g_looperCnt;
+static TFW_AtomicInt64 g_handleSeq;
 
 TFW_Looper *TFW_GetLooper(TFW_LooperType type)
 {
@@ -55,6 +166,11 @@ TFW_Looper *TFW_GetLooper(TFW_LooperType type)
     return g_looperConfig[type].looper;
 }
 
+TFW_Executor *TFW_GetDefaultExecutor(void)
+{
+    return g_defaultExecutor;
+}
+
 void TFW_SetLooper(TFW_LooperType type, TFW_Looper *looper)
 {
     // 检查类型是否有效
@@ -76,380 +192,2207 @@ static void ReleaseLooper(const TFW_Looper *looper)
     }
 }
 
-static int64_t UptimeMicros(void)
+// ============================================================================
+// 命名looper注册表：按名称散列，引用计数归零时销毁
+// Named looper registry: hashed by name, destroyed when the last reference is released
+// ============================================================================
+
+enum {
+    REGISTRY_UNINIT = 0,
+    REGISTRY_INITING,
+    REGISTRY_READY,
+};
+
+static TFW_AtomicInt32 g_registryState;
+static TFW_Mutex_t g_registryLock;            // 初始化后不再销毁，looper可在TFW_LooperInit之前创建
+static TFW_MutexAttr_t g_registryLockAttr;
+static TFW_ListNode *g_registryBuckets = NULL;
+static uint32_t g_registryBucketCnt = 0;
+static uint32_t g_registryCnt = 0;
+
+static void RegistryLock(void)
 {
-    return (int64_t)TFW_GetTimestampUs();
+    if (TFW_AtomicLoad32(&g_registryState) != REGISTRY_READY) {
+        if (TFW_AtomicCompareAndSwap32(&g_registryState, REGISTRY_UNINIT, REGISTRY_INITING)) {
+            TFW_MutexAttr_Init(&g_registryLockAttr);
+            TFW_Mutex_Init(&g_registryLock, &g_registryLockAttr);
+            TFW_AtomicStore32(&g_registryState, REGISTRY_READY);
+        }
+        while (TFW_AtomicLoad32(&g_registryState) != REGISTRY_READY) {
+        }
+    }
+    (void)TFW_Mutex_Lock(&g_registryLock);
 }
 
-static void FreeTFWMsg(TFW_Message *msg)
+static void RegistryUnlock(void)
 {
-    if (msg->FreeMessage == NULL) {
-        TFW_Free(msg);
-    } else {
-        msg->FreeMessage(msg);
-    }
+    (void)TFW_Mutex_Unlock(&g_registryLock);
 }
 
-TFW_Message *TFW_MallocMessage(void)
+// FNV-1a
+static uint32_t RegistryHash(const char *name)
 {
-    TFW_Message *msg = (TFW_Message *)TFW_Calloc(sizeof(TFW_Message));
-    if (msg == NULL) {
-        TFW_LOGE_UTILS("malloc TFW_Message failed");
-        return NULL;
+    uint32_t hash = 2166136261U;
+    for (const unsigned char *c = (const unsigned char *)name; *c != '\0'; c++) {
+        hash = (hash ^ *c) * 16777619U;
     }
-    return msg;
+    return hash;
 }
 
-void TFW_FreeMessage(TFW_Message *msg)
+static TFW_ListNode *RegistryBucket(const char *name)
 {
-    if (msg != NULL) {
-        FreeTFWMsg(msg);
-    }
+    return &g_registryBuckets[RegistryHash(name) & (g_registryBucketCnt - 1)];
 }
 
-static void DumpLooperLocked(const TFW_Looper *looper)
+// 扩容失败时保留原桶数组
+static void RegistryGrowLocked(void)
 {
-    if (looper == NULL || looper->context == NULL) {
-        TFW_LOGE_UTILS("Invalid looper or context");
+    uint32_t newCnt = (g_registryBucketCnt == 0) ? REGISTRY_INIT_BUCKETS : g_registryBucketCnt * 2;
+    TFW_ListNode *newBuckets = (TFW_ListNode *)TFW_Malloc(sizeof(TFW_ListNode) * newCnt);
+    if (newBuckets == NULL) {
         return;
     }
-
-    const TFW_LooperContext *context = looper->context;
-    if (context->currentMsg != NULL) {
-        TFW_LOGD_UTILS("Current Message - What: %d, Time: %lld",
-                        context->currentMsg->what, context->currentMsg->time);
+    for (uint32_t i = 0; i < newCnt; i++) {
+        TFW_ListInit(&newBuckets[i]);
     }
-
-    // 遍历消息队列并打印信息
-    if (!TFW_IsListEmpty(&context->msgHead)) {
-        TFW_ListNode *item = NULL;
-        TFW_ListNode *nextItem = NULL;
-        uint32_t count = 0;
-
-        TFW_LIST_FOR_EACH_SAFE(item, nextItem, &context->msgHead) {
-            TFW_MessageNode *itemNode = TFW_LIST_ENTRY(item, TFW_MessageNode, node);
-            if (itemNode->msg != NULL) {
-                TFW_LOGD_UTILS("Message[%u] - What: %d, Time: %lld, Handler: %s",
-                                count, itemNode->msg->what, itemNode->msg->time,
-                                (itemNode->msg->handler && itemNode->msg->handler->name) ?
-                                itemNode->msg->handler->name : "null");
-                count++;
-
-                // 避免打印过多信息
-                if (count >= MAX_LOOPER_PRINT_CNT) {
-                    TFW_LOGD_UTILS("... and more messages");
-                    break;
-                }
-            }
+    TFW_ListNode *oldBuckets = g_registryBuckets;
+    uint32_t oldCnt = g_registryBucketCnt;
+    g_registryBuckets = newBuckets;
+    g_registryBucketCnt = newCnt;
+    for (uint32_t i = 0; i < oldCnt; i++) {
+        while (!TFW_IsListEmpty(&oldBuckets[i])) {
+            TFW_LooperContext *context = TFW_LIST_ENTRY(oldBuckets[i].next, TFW_LooperContext, regNode);
+            TFW_ListDelete(&context->regNode);
+            TFW_ListTailInsert(RegistryBucket(context->name), &context->regNode);
         }
     }
+    TFW_Free(oldBuckets);
 }
 
-void DumpLooper(const TFW_Looper *looper)
+static TFW_Looper *RegistryFindLocked(const char *name)
 {
-    if (looper == NULL || looper->context == NULL) {
-        TFW_LOGE_UTILS("Invalid looper or context");
-        return;
+    if (g_registryBucketCnt == 0) {
+        return NULL;
     }
-
-    TFW_LooperContext *context = looper->context;
-    if (TFW_Mutex_Lock(&context->lock) != 0) {
-        TFW_LOGE_UTILS("Failed to lock looper mutex");
-        return;
+    TFW_ListNode *item = NULL;
+    TFW_LIST_FOR_EACH(item, RegistryBucket(name)) {
+        TFW_LooperContext *context = TFW_LIST_ENTRY(item, TFW_LooperContext, regNode);
+        if (strcmp(context->name, name) == 0) {
+            return context->looper;
+        }
     }
-
-    DumpLooperLocked(looper);
-
-    (void)TFW_Mutex_Unlock(&context->lock);
+    return NULL;
 }
 
-// ... existing code ...
-
-static void *LoopTask(void *arg)
+static int32_t RegistryInsertLocked(TFW_Looper *looper)
 {
-    TFW_Looper *looper = (TFW_Looper *)arg;
     TFW_LooperContext *context = looper->context;
-    if (context == NULL) {
-        TFW_LOGE_UTILS("loop context is NULL");
-        return NULL;
+    if (g_registryCnt >= g_registryBucketCnt * REGISTRY_LOAD_FACTOR) {
+        RegistryGrowLocked();
+        if (g_registryBucketCnt == 0) {
+            return TFW_ERROR_MALLOC_ERR;
+        }
     }
+    TFW_ListTailInsert(RegistryBucket(context->name), &context->regNode);
+    context->refs = 1;
+    context->registered = true;
+    g_registryCnt++;
+    return TFW_SUCCESS;
+}
 
-    TFW_LOGD_UTILS("LoopTask running. name=%s", context->name);
-
-    if (TFW_Mutex_Lock(&context->lock) != 0) {
-        TFW_LOGE_UTILS("lock failed");
-        return NULL;
+static void RegistryUnlinkLocked(TFW_LooperContext *context)
+{
+    if (!context->registered) {
+        return;
     }
-    context->running = 1;
-    (void)TFW_Mutex_Unlock(&context->lock);
+    TFW_ListDelete(&context->regNode);
+    context->registered = false;
+    g_registryCnt--;
+}
 
-    for (;;) {
-        if (TFW_Mutex_Lock(&context->lock) != 0) {
-            return NULL;
-        }
-        // wait
-        if (context->stop == 1) {
-            TFW_LOGI_UTILS("LoopTask stop is 1. name=%s", context->name);
-            (void)TFW_Mutex_Unlock(&context->lock);
-            break;
-        }
+static int64_t UptimeMicros(void)
+{
+    return (int64_t)TFW_GetTimestampUs();
+}
 
-        if (TFW_IsListEmpty(&context->msgHead)) {
-            TFW_LOGD_UTILS("LoopTask wait msg list empty. name=%s", context->name);
-            // 使用条件变量等待新消息，替代轮询等待
-            TFW_Cond_Wait(&context->cond, &context->lock, NULL);
-            (void)TFW_Mutex_Unlock(&context->lock);
-            continue;
-        }
+// ============================================================================
+// 消息池：线程局部缓存 + 全局无锁空闲栈
+// Message pool: thread local cache + global lock-free free stack
+// ============================================================================
+
+#define MESSAGE_POOL_LOCAL_MAX 32U  // 每个线程本地缓存的消息上限
+
+static TFW_AtomicPtr g_msgPoolHead;                 // 全局空闲栈，push使用CAS，pop一次性取走整条链
+static TFW_AtomicInt32 g_msgPoolGlobalCnt;          // 全局空闲栈中的消息数量
+static TFW_AtomicInt32 g_msgPoolHighWater = { TFW_MESSAGE_POOL_HIGH_WATER_DEFAULT };
+static TFW_THREAD_LOCAL TFW_Message *g_msgPoolLocalHead = NULL;
+static TFW_THREAD_LOCAL uint32_t g_msgPoolLocalCnt = 0;
+
+// 线程退出时归还本地缓存：任意线程首次使用本地缓存前登记线程局部键，键的析构回调负责归还
+enum {
+    MSG_POOL_KEY_UNINIT = 0,
+    MSG_POOL_KEY_INITING,
+    MSG_POOL_KEY_READY,
+    MSG_POOL_KEY_FAILED,
+};
 
-        int64_t now = UptimeMicros();
-        TFW_ListNode *item = context->msgHead.next;
-        TFW_Message *msg = NULL;
-        TFW_MessageNode *itemNode = TFW_LIST_ENTRY(item, TFW_MessageNode, node);
-        int64_t time = itemNode->msg->time;
-        if (now >= time) {
-            msg = itemNode->msg;
-            TFW_ListDelete(item);
-            TFW_Free(itemNode);
-            context->msgSize--;
-            if (looper->dumpable) {
-                TFW_LOGD_UTILS(
-                    "LoopTask get message. name=%s, handle=%s, what=%d, arg1=%llu, msgSize=%u, time=%lld",
-                    context->name, msg->handler ? msg->handler->name : "null", msg->what, msg->arg1, context->msgSize,
-                    msg->time);
-            }
-        } else {
-            // 使用条件变量的定时等待功能，在指定时间点自动唤醒
-            TFW_SysTime tv;
-            tv.sec = time / TIME_THOUSANDS_MULTIPLIER / TIME_THOUSANDS_MULTIPLIER;
-            tv.nsec = (time % (TIME_THOUSANDS_MULTIPLIER * TIME_THOUSANDS_MULTIPLIER)) * 1000; // 转换为纳秒
-            TFW_Cond_Wait(&context->cond, &context->lock, &tv);
-            (void)TFW_Mutex_Unlock(&context->lock);
-            continue;
-        }
+static TFW_AtomicInt32 g_msgPoolKeyState;
+static TFW_ThreadKey_t g_msgPoolKey;
+static TFW_THREAD_LOCAL bool g_msgPoolLocalArmed = false;
 
-        if (msg == NULL) {
-            (void)TFW_Mutex_Unlock(&context->lock);
-            continue;
-        }
-        context->currentMsg = msg;
-        (void)TFW_Mutex_Unlock(&context->lock);
-        if (looper->dumpable) {
-            TFW_LOGD_UTILS(
-                "LoopTask HandleMessage message. name=%s, handle=%s, what=%d",
-                context->name, msg->handler ? msg->handler->name : "null", msg->what);
-        }
+static void MsgPoolThreadExit(void *arg)
+{
+    (void)arg;
+    TFW_FlushMessagePoolLocal();
+    // 其他析构回调中释放的消息会重新登记，由平台再次调用本回调
+    g_msgPoolLocalArmed = false;
+}
 
-        if (msg->handler != NULL && msg->handler->HandleMessage != NULL) {
-            msg->handler->HandleMessage(msg);
+// 返回当前线程能否使用本地缓存；键创建失败时所有线程直接使用全局栈
+static bool MsgPoolArmLocal(void)
+{
+    if (g_msgPoolLocalArmed) {
+        return true;
+    }
+    if (TFW_AtomicLoad32(&g_msgPoolKeyState) != MSG_POOL_KEY_READY) {
+        if (TFW_AtomicCompareAndSwap32(&g_msgPoolKeyState, MSG_POOL_KEY_UNINIT, MSG_POOL_KEY_INITING)) {
+            int32_t ret = TFW_ThreadKey_Create(&g_msgPoolKey, MsgPoolThreadExit);
+            TFW_AtomicStore32(&g_msgPoolKeyState, (ret == TFW_SUCCESS) ? MSG_POOL_KEY_READY : MSG_POOL_KEY_FAILED);
         }
-        if (looper->dumpable) {
-            TFW_LOGD_UTILS(
-                "LoopTask after HandleMessage message. "
-                "name=%s, what=%d, arg1=%llu",
-                context->name, msg->what, msg->arg1);
+        while (TFW_AtomicLoad32(&g_msgPoolKeyState) == MSG_POOL_KEY_INITING) {
+        }
+        if (TFW_AtomicLoad32(&g_msgPoolKeyState) != MSG_POOL_KEY_READY) {
+            return false;
         }
-        (void)TFW_Mutex_Lock(&context->lock);
-        FreeTFWMsg(msg);
-        context->currentMsg = NULL;
-        (void)TFW_Mutex_Unlock(&context->lock);
     }
-    (void)TFW_Mutex_Lock(&context->lock);
-    context->running = 0;
-    TFW_LOGI_UTILS("LoopTask running is 0. name=%s", context->name);
-    // 使用条件变量广播通知，优化TFW_DestroyLooper中的等待逻辑
-    TFW_Cond_Broadcast(&context->condRunning);
-    (void)TFW_Mutex_Unlock(&context->lock);
-    return NULL;
+    // 值只用于触发析构回调，须非空
+    g_msgPoolLocalArmed = (TFW_ThreadKey_SetValue(g_msgPoolKey, &g_msgPoolLocalArmed) == TFW_SUCCESS);
+    return g_msgPoolLocalArmed;
 }
 
-static int32_t StartNewLooperThread(TFW_Looper *looper)
+// 本地缓存仅由当前线程访问，无需原子操作
+static void MsgPoolLocalPush(TFW_Message *msg)
 {
-    TFW_ThreadAttr attr;
-    TFW_ThreadAttr_Init(&attr);
-    attr.name = looper->context->name;
-
-    TFW_Thread_t tid;
-    int32_t ret = TFW_Thread_Create(&tid, &attr, LoopTask, looper);
-    if (ret != TFW_SUCCESS) {
-        TFW_LOGE_UTILS("Init LoopTask Thread failed");
-        return ret;
-    }
-
-    TFW_LOGI_UTILS("loop thread creating. name=%s", looper->context->name);
-    return TFW_SUCCESS;
+    msg->link.next.ptr = g_msgPoolLocalHead;
+    g_msgPoolLocalHead = msg;
+    g_msgPoolLocalCnt++;
 }
 
-static int32_t PostMessageAtTimeParamVerify(const TFW_Looper *looper, TFW_Message *msgPost)
+static TFW_Message *MsgPoolLocalPop(void)
 {
-    if (msgPost == NULL) {
-        TFW_LOGE_UTILS("the msgPost param is null.");
-        return TFW_ERROR_INVALID_PARAM;
-    }
-
-    if (looper == NULL) {
-        TFW_LOGE_UTILS("the looper param is null.");
-        return TFW_ERROR_INVALID_PARAM;
-    }
-
-    if (looper->dumpable) {
-        TFW_LOGD_UTILS("PostMessageAtTime name=%s, what=%d, time=%lldus",
-            looper->context->name, msgPost->what, msgPost->time);
-    }
-
-    if (msgPost->handler == NULL) {
-        TFW_LOGE_UTILS("[%s] msg handler is null", looper->context->name);
-        return TFW_ERROR_LOOPER_ERROR;
+    TFW_Message *msg = g_msgPoolLocalHead;
+    if (msg != NULL) {
+        g_msgPoolLocalHead = (TFW_Message *)msg->link.next.ptr;
+        g_msgPoolLocalCnt--;
     }
-
-    return TFW_SUCCESS;
+    return msg;
 }
 
-static void PostMessageAtTime(const TFW_Looper *looper, TFW_Message *msgPost)
+// 本地缓存已满时归还全局栈，超过上限则直接释放
+static void MsgPoolGlobalPush(TFW_Message *msg)
 {
-    if (PostMessageAtTimeParamVerify(looper, msgPost) != 0) {
-        FreeTFWMsg(msgPost);
+    if (TFW_AtomicInc32(&g_msgPoolGlobalCnt) > TFW_AtomicLoad32(&g_msgPoolHighWater)) {
+        (void)TFW_AtomicDec32(&g_msgPoolGlobalCnt);
+        TFW_Free(msg);
         return;
     }
+    void *head = NULL;
+    do {
+        head = TFW_AtomicLoadPtr(&g_msgPoolHead);
+        TFW_AtomicStorePtr(&msg->link.next, head);
+    } while (!TFW_AtomicCompareAndSwapPtr(&g_msgPoolHead, head, msg));
+}
 
-    TFW_MessageNode *newNode = (TFW_MessageNode *)TFW_Calloc(sizeof(TFW_MessageNode));
-    if (newNode == NULL) {
-        TFW_LOGE_UTILS("message node malloc failed.");
-        FreeTFWMsg(msgPost);
-        return;
-    }
-    TFW_ListInit(&newNode->node);
-    newNode->msg = msgPost;
-    TFW_LooperContext *context = looper->context;
-    if (TFW_Mutex_Lock(&context->lock) != 0) {
-        TFW_Free(newNode);
-        FreeTFWMsg(msgPost);
-        return;
+// 一次性取走全局栈填充本地缓存，只有交换没有逐个弹出，不存在ABA问题；
+// 超出本地上限的部分整段拼回全局栈，避免消息滞留在即将退出的线程中
+static void MsgPoolRefillLocal(void)
+{
+    TFW_Message *msg = (TFW_Message *)TFW_AtomicExchangePtr(&g_msgPoolHead, NULL);
+    while (msg != NULL && g_msgPoolLocalCnt < MESSAGE_POOL_LOCAL_MAX) {
+        TFW_Message *next = (TFW_Message *)TFW_AtomicLoadPtr(&msg->link.next);
+        (void)TFW_AtomicDec32(&g_msgPoolGlobalCnt);
+        MsgPoolLocalPush(msg);
+        msg = next;
     }
-    if (context->stop == 1) {
-        TFW_Free(newNode);
-        FreeTFWMsg(msgPost);
-        (void)TFW_Mutex_Unlock(&context->lock);
-        TFW_LOGE_UTILS("PostMessageAtTime stop is 1. name=%s, running=%d",
-            context->name, context->running);
+    if (msg == NULL) {
         return;
     }
-    TFW_ListNode *item = NULL;
-    TFW_ListNode *nextItem = NULL;
-    bool insert = false;
-    TFW_LIST_FOR_EACH_SAFE(item, nextItem, &context->msgHead) {
-        TFW_MessageNode *itemNode = TFW_LIST_ENTRY(item, TFW_MessageNode, node);
-        TFW_Message *msg = itemNode->msg;
-        if (msg->time > msgPost->time) {
-            TFW_ListTailInsert(item, &(newNode->node));
-            insert = true;
-            break;
-        }
-    }
-    if (!insert) {
-        TFW_ListTailInsert(&(context->msgHead), &(newNode->node));
-    }
-    context->msgSize++;
-    if (looper->dumpable) {
-        TFW_LOGD_UTILS("PostMessageAtTime insert. name=%s", context->name);
-        DumpLooperLocked(looper);
+    TFW_Message *tail = msg;
+    TFW_Message *next = NULL;
+    while ((next = (TFW_Message *)TFW_AtomicLoadPtr(&tail->link.next)) != NULL) {
+        tail = next;
     }
-    TFW_Cond_Broadcast(&context->cond);
-    (void)TFW_Mutex_Unlock(&context->lock);
+    void *head = NULL;
+    do {
+        head = TFW_AtomicLoadPtr(&g_msgPoolHead);
+        TFW_AtomicStorePtr(&tail->link.next, head);
+    } while (!TFW_AtomicCompareAndSwapPtr(&g_msgPoolHead, head, msg));
 }
 
-static void LooperPostMessage(const TFW_Looper *looper, TFW_Message *msg)
+static void FreeTFWMsg(TFW_Message *msg)
 {
-    if (msg == NULL) {
-        TFW_LOGE_UTILS("LooperPostMessage with nullmsg");
+    if (msg->FreeMessage != NULL) {
+        msg->FreeMessage(msg);
         return;
     }
-    if (looper == NULL) {
-        TFW_LOGE_UTILS("LooperPostMessage with nulllooper");
+    if (g_msgPoolLocalCnt < MESSAGE_POOL_LOCAL_MAX &&
+        g_msgPoolLocalCnt < (uint32_t)TFW_AtomicLoad32(&g_msgPoolHighWater) && MsgPoolArmLocal()) {
+        MsgPoolLocalPush(msg);
         return;
     }
-    msg->time = UptimeMicros();
-    PostMessageAtTime(looper, msg);
+    MsgPoolGlobalPush(msg);
 }
 
-static void LooperPostMessageDelay(const TFW_Looper *looper, TFW_Message *msg, uint64_t delayMillis)
+TFW_Message *TFW_MallocMessage(void)
 {
+    TFW_Message *msg = MsgPoolLocalPop();
+    if (msg == NULL && TFW_AtomicLoadPtr(&g_msgPoolHead) != NULL && MsgPoolArmLocal()) {
+        MsgPoolRefillLocal();
+        msg = MsgPoolLocalPop();
+    }
+    if (msg != NULL) {
+        (void)TFW_Memset_S(msg, sizeof(TFW_Message), 0, sizeof(TFW_Message));
+        return msg;
+    }
+    msg = (TFW_Message *)TFW_Calloc(sizeof(TFW_Message));
     if (msg == NULL) {
-        TFW_LOGE_UTILS("LooperPostMessageDelay with nullmsg");
-        return;
+        TFW_LOGE_UTILS("malloc TFW_Message failed");
+        return NULL;
     }
-    if (looper == NULL) {
-        TFW_LOGE_UTILS("LooperPostMessageDelay with nulllooper");
-        return;
+    return msg;
+}
+
+void TFW_FreeMessage(TFW_Message *msg)
+{
+    if (msg != NULL) {
+        FreeTFWMsg(msg);
     }
-    msg->time = UptimeMicros() + (int64_t)delayMillis * TIME_THOUSANDS_MULTIPLIER;
-    PostMessageAtTime(looper, msg);
 }
 
-static int32_t WhatRemoveFunc(const TFW_Message *msg, void *args)
+void TFW_FlushMessagePoolLocal(void)
 {
-    int32_t what = (int32_t)(intptr_t)args;
-    if (msg->what == what) {
-        return 0;
+    // 逐个归还全局栈，超过上限的部分由MsgPoolGlobalPush直接释放
+    TFW_Message *msg = NULL;
+    while ((msg = MsgPoolLocalPop()) != NULL) {
+        MsgPoolGlobalPush(msg);
     }
-    return 1;
 }
 
-static void LoopRemoveMessageCustom(const TFW_Looper *looper, const TFW_Handler *handler,
-    int32_t (*customFunc)(const TFW_Message*, void*), void *args)
+void TFW_SetMessagePoolHighWater(uint32_t highWater)
 {
-    TFW_LooperContext *context = looper->context;
-    if (TFW_Mutex_Lock(&context->lock) != 0) {
-        return;
+    if (highWater > (uint32_t)INT32_MAX) {
+        highWater = (uint32_t)INT32_MAX;
     }
-    if (context->running == 0 || context->stop == 1) {
-        (void)TFW_Mutex_Unlock(&context->lock);
+    TFW_AtomicStore32(&g_msgPoolHighWater, (int32_t)highWater);
+    if (highWater != 0) {
         return;
     }
-    TFW_ListNode *item = NULL;
-    TFW_ListNode *nextItem = NULL;
-    TFW_LIST_FOR_EACH_SAFE(item, nextItem, &context->msgHead) {
-        TFW_MessageNode *itemNode = TFW_LIST_ENTRY(item, TFW_MessageNode, node);
-        TFW_Message *msg = itemNode->msg;
-        if (msg->handler == handler && customFunc(msg, args) == 0) {
-            TFW_LOGD_UTILS(
-                "LooperRemoveMessage. name=%s, handler=%s, what=%d, arg1=%llu, "
-                "time=%lld",
-                context->name, handler->name, msg->what, msg->arg1, msg->time);
-            FreeTFWMsg(msg);
-            TFW_ListDelete(&itemNode->node);
-            TFW_Free(itemNode);
-            context->msgSize--;
-        }
+    // 关闭消息池时释放已缓存的消息
+    TFW_Message *msg = NULL;
+    while ((msg = MsgPoolLocalPop()) != NULL) {
+        TFW_Free(msg);
+    }
+    msg = (TFW_Message *)TFW_AtomicExchangePtr(&g_msgPoolHead, NULL);
+    while (msg != NULL) {
+        TFW_Message *next = (TFW_Message *)TFW_AtomicLoadPtr(&msg->link.next);
+        (void)TFW_AtomicDec32(&g_msgPoolGlobalCnt);
+        TFW_Free(msg);
+        msg = next;
     }
-    (void)TFW_Mutex_Unlock(&context->lock);
 }
 
-static void LooperRemoveMessage(const TFW_Looper *looper, const TFW_Handler *handler, int32_t what)
+void TFW_TrimMessagePool(void)
 {
-    LoopRemoveMessageCustom(looper, handler, WhatRemoveFunc, (void*)(intptr_t)what);
+    // 每次释放全局栈中的一半，持续空闲时池逐步收缩，流量恢复时不会一次性失去全部缓存
+    TFW_Message *msg = (TFW_Message *)TFW_AtomicExchangePtr(&g_msgPoolHead, NULL);
+    uint32_t total = 0;
+    for (TFW_Message *item = msg; item != NULL; item = (TFW_Message *)TFW_AtomicLoadPtr(&item->link.next)) {
+        total++;
+    }
+    TFW_Message *keep = NULL;
+    for (uint32_t i = 0; i < total; i++) {
+        TFW_Message *next = (TFW_Message *)TFW_AtomicLoadPtr(&msg->link.next);
+        if (i < total / 2) {
+            TFW_AtomicStorePtr(&msg->link.next, keep);
+            keep = msg;
+        } else {
+            (void)TFW_AtomicDec32(&g_msgPoolGlobalCnt);
+            TFW_Free(msg);
+        }
+        msg = next;
+    }
+    while (keep != NULL) {
+        TFW_Message *next = (TFW_Message *)TFW_AtomicLoadPtr(&keep->link.next);
+        (void)TFW_AtomicDec32(&g_msgPoolGlobalCnt);
+        MsgPoolGlobalPush(keep);
+        keep = next;
+    }
 }
 
-void TFW_SetLooperDumpable(TFW_Looper *loop, bool dumpable)
+// ============================================================================
+// 消息队列：即时消息FIFO + 延时消息最小堆
+// Message queue: FIFO for immediate messages + min-heap for delayed messages
+// ============================================================================
+
+static bool MessageNodeBefore(const TFW_Message *a, const TFW_Message *b)
 {
-    if (loop == NULL) {
-        TFW_LOGE_UTILS("loop is null");
-        return;
+    if (a->time != b->time) {
+        return a->time < b->time;
     }
-    loop->dumpable = dumpable;
+    return a->link.seq < b->link.seq;
 }
 
-TFW_Looper *TFW_CreateNewLooper(const char *name)
+static void TimerHeapSet(TFW_LooperLane *lane, uint32_t index, TFW_Message *node)
 {
-    if (g_looperCnt >= (MAX_LOOPER_CNT)) {
-        TFW_LOGE_UTILS("Looper exceeds the maximum, count=%u,", g_looperCnt);
-        return NULL;
-    }
+    lane->timerHeap[index] = node;
+    node->link.heapIndex = index;
+}
 
-    TFW_Looper *looper = (TFW_Looper *)TFW_Calloc(sizeof(TFW_Looper));
-    if (looper == NULL) {
-        TFW_LOGE_UTILS("Looper TFW_Calloc fail");
-        return NULL;
+static void TimerHeapSiftUp(TFW_LooperLane *lane, uint32_t index)
+{
+    TFW_Message *node = lane->timerHeap[index];
+    while (index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if (!MessageNodeBefore(node, lane->timerHeap[parent])) {
+            break;
+        }
+        TimerHeapSet(lane, index, lane->timerHeap[parent]);
+        index = parent;
+    }
+    TimerHeapSet(lane, index, node);
+}
+
+static void TimerHeapSiftDown(TFW_LooperLane *lane, uint32_t index)
+{
+    TFW_Message *node = lane->timerHeap[index];
+    uint32_t size = lane->timerHeapSize;
+    for (;;) {
+        uint32_t child = index * 2 + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && MessageNodeBefore(lane->timerHeap[child + 1], lane->timerHeap[child])) {
+            child++;
+        }
+        if (!MessageNodeBefore(lane->timerHeap[child], node)) {
+            break;
+        }
+        TimerHeapSet(lane, index, lane->timerHeap[child]);
+        index = child;
+    }
+    TimerHeapSet(lane, index, node);
+}
+
+static int32_t TimerHeapGrow(TFW_LooperLane *lane)
+{
+    uint32_t newCap = (lane->timerHeapCap == 0) ? TIMER_HEAP_INIT_CAP : lane->timerHeapCap * 2;
+    if (newCap <= lane->timerHeapCap || newCap > TFW_MAX_MALLOC_SIZE / sizeof(TFW_Message *)) {
+        TFW_LOGE_UTILS("timer heap too large. cap=%u", lane->timerHeapCap);
+        return TFW_ERROR_MALLOC_ERR;
+    }
+
+    TFW_Message **newHeap = (TFW_Message **)TFW_Malloc(newCap * (uint32_t)sizeof(TFW_Message *));
+    if (newHeap == NULL) {
+        TFW_LOGE_UTILS("timer heap malloc failed. cap=%u", newCap);
+        return TFW_ERROR_MALLOC_ERR;
+    }
+    if (lane->timerHeapSize > 0) {
+        (void)TFW_Memcpy_S(newHeap, newCap * sizeof(TFW_Message *), lane->timerHeap,
+            lane->timerHeapSize * sizeof(TFW_Message *));
+    }
+    TFW_Free(lane->timerHeap);
+    lane->timerHeap = newHeap;
+    lane->timerHeapCap = newCap;
+    return TFW_SUCCESS;
+}
+
+static int32_t TimerHeapPush(TFW_LooperLane *lane, TFW_Message *node)
+{
+    if (lane->timerHeapSize == lane->timerHeapCap) {
+        int32_t ret = TimerHeapGrow(lane);
+        if (ret != TFW_SUCCESS) {
+            return ret;
+        }
+    }
+    uint32_t index = lane->timerHeapSize++;
+    TimerHeapSet(lane, index, node);
+    TimerHeapSiftUp(lane, index);
+    return TFW_SUCCESS;
+}
+
+static void TimerHeapRemoveAt(TFW_LooperLane *lane, uint32_t index)
+{
+    TFW_Message *node = lane->timerHeap[index];
+    uint32_t last = --lane->timerHeapSize;
+    node->link.heapIndex = TIMER_HEAP_INVALID_INDEX;
+    if (index == last) {
+        return;
+    }
+    TimerHeapSet(lane, index, lane->timerHeap[last]);
+    if (index > 0 && MessageNodeBefore(lane->timerHeap[index], lane->timerHeap[(index - 1) / 2])) {
+        TimerHeapSiftUp(lane, index);
+    } else {
+        TimerHeapSiftDown(lane, index);
+    }
+}
+
+// 批量删除后重建堆，O(n)
+static void TimerHeapRebuild(TFW_LooperLane *lane)
+{
+    for (uint32_t i = lane->timerHeapSize / 2; i > 0; i--) {
+        TimerHeapSiftDown(lane, i - 1);
+    }
+}
+
+// ============================================================================
+// (handler, what)索引
+// (handler, what) index
+// ============================================================================
+
+static uint32_t MsgIndexHash(const TFW_Handler *handler, int32_t what)
+{
+    uint64_t key = (uint64_t)(uintptr_t)handler ^ ((uint64_t)(uint32_t)what * 0x9E3779B97F4A7C15ULL);
+    key ^= key >> 29;
+    key *= 0xBF58476D1CE4E5B9ULL;
+    key ^= key >> 32;
+    return (uint32_t)key;
+}
+
+static TFW_ListNode *MsgIndexBucket(const TFW_LooperContext *context, const TFW_Handler *handler, int32_t what)
+{
+    return &context->indexBuckets[MsgIndexHash(handler, what) & (context->indexBucketCnt - 1)];
+}
+
+static int32_t MsgIndexInit(TFW_LooperContext *context)
+{
+    context->indexBuckets = (TFW_ListNode *)TFW_Malloc(sizeof(TFW_ListNode) * MSG_INDEX_INIT_BUCKETS);
+    if (context->indexBuckets == NULL) {
+        return TFW_ERROR_MALLOC_ERR;
+    }
+    context->indexBucketCnt = MSG_INDEX_INIT_BUCKETS;
+    for (uint32_t i = 0; i < MSG_INDEX_INIT_BUCKETS; i++) {
+        TFW_ListInit(&context->indexBuckets[i]);
+    }
+    return TFW_SUCCESS;
+}
+
+// 扩容失败时保留原桶数组，索引仍然正确，只是桶链更长
+static void MsgIndexGrowLocked(TFW_LooperContext *context)
+{
+    uint32_t newCnt = context->indexBucketCnt * 2;
+    TFW_ListNode *newBuckets = (TFW_ListNode *)TFW_Malloc(sizeof(TFW_ListNode) * newCnt);
+    if (newBuckets == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < newCnt; i++) {
+        TFW_ListInit(&newBuckets[i]);
+    }
+    TFW_ListNode *oldBuckets = context->indexBuckets;
+    uint32_t oldCnt = context->indexBucketCnt;
+    context->indexBuckets = newBuckets;
+    context->indexBucketCnt = newCnt;
+    for (uint32_t i = 0; i < oldCnt; i++) {
+        while (!TFW_IsListEmpty(&oldBuckets[i])) {
+            TFW_Message *msg = TFW_LIST_ENTRY(oldBuckets[i].next, TFW_Message, link.indexNode);
+            TFW_ListDelete(&msg->link.indexNode);
+            TFW_ListTailInsert(MsgIndexBucket(context, msg->handler, msg->what), &msg->link.indexNode);
+        }
+    }
+    TFW_Free(oldBuckets);
+}
+
+static TFW_LooperLane *LaneOf(TFW_LooperContext *context, const TFW_Message *msg)
+{
+    uint32_t priority = (uint32_t)msg->priority;
+    return &context->lanes[(priority < TFW_MSG_PRIORITY_MAX) ? priority : TFW_MSG_PRIORITY_NORMAL];
+}
+
+// ============================================================================
+// 取消句柄索引
+// Cancellation handle index
+// ============================================================================
+
+// 句柄连续递增，取低位即可均匀散列
+static TFW_ListNode *HandleBucket(const TFW_LooperContext *context, uint64_t handle)
+{
+    return &context->handleBuckets[handle & (context->handleBucketCnt - 1)];
+}
+
+static int32_t HandleIndexInit(TFW_LooperContext *context)
+{
+    context->handleBuckets = (TFW_ListNode *)TFW_Malloc(sizeof(TFW_ListNode) * MSG_INDEX_INIT_BUCKETS);
+    if (context->handleBuckets == NULL) {
+        return TFW_ERROR_MALLOC_ERR;
+    }
+    context->handleBucketCnt = MSG_INDEX_INIT_BUCKETS;
+    context->handleCnt = 0;
+    for (uint32_t i = 0; i < MSG_INDEX_INIT_BUCKETS; i++) {
+        TFW_ListInit(&context->handleBuckets[i]);
+    }
+    return TFW_SUCCESS;
+}
+
+// 扩容失败时保留原桶数组
+static void HandleIndexGrowLocked(TFW_LooperContext *context)
+{
+    uint32_t newCnt = context->handleBucketCnt * 2;
+    TFW_ListNode *newBuckets = (TFW_ListNode *)TFW_Malloc(sizeof(TFW_ListNode) * newCnt);
+    if (newBuckets == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < newCnt; i++) {
+        TFW_ListInit(&newBuckets[i]);
+    }
+    TFW_ListNode *oldBuckets = context->handleBuckets;
+    uint32_t oldCnt = context->handleBucketCnt;
+    context->handleBuckets = newBuckets;
+    context->handleBucketCnt = newCnt;
+    for (uint32_t i = 0; i < oldCnt; i++) {
+        while (!TFW_IsListEmpty(&oldBuckets[i])) {
+            TFW_Message *msg = TFW_LIST_ENTRY(oldBuckets[i].next, TFW_Message, link.handleNode);
+            TFW_ListDelete(&msg->link.handleNode);
+            TFW_ListTailInsert(HandleBucket(context, msg->link.handle), &msg->link.handleNode);
+        }
+    }
+    TFW_Free(oldBuckets);
+}
+
+static void HandleIndexInsertLocked(TFW_LooperContext *context, TFW_Message *msg)
+{
+    if (msg->link.handle == TFW_MESSAGE_HANDLE_INVALID) {
+        return;
+    }
+    context->handleCnt++;
+    if (context->handleCnt > context->handleBucketCnt * MSG_INDEX_LOAD_FACTOR) {
+        HandleIndexGrowLocked(context);
+    }
+    TFW_ListTailInsert(HandleBucket(context, msg->link.handle), &msg->link.handleNode);
+}
+
+// 可重复调用，已移出索引的消息节点指向自身
+static void HandleIndexRemoveLocked(TFW_LooperContext *context, TFW_Message *msg)
+{
+    if (msg->link.handle == TFW_MESSAGE_HANDLE_INVALID || TFW_IsListEmpty(&msg->link.handleNode)) {
+        return;
+    }
+    TFW_ListDelete(&msg->link.handleNode);
+    context->handleCnt--;
+}
+
+static TFW_Message *HandleIndexFindLocked(const TFW_LooperContext *context, uint64_t handle)
+{
+    TFW_ListNode *item = NULL;
+    TFW_LIST_FOR_EACH(item, HandleBucket(context, handle)) {
+        TFW_Message *msg = TFW_LIST_ENTRY(item, TFW_Message, link.handleNode);
+        if (msg->link.handle == handle) {
+            return msg;
+        }
+    }
+    return NULL;
+}
+
+// 消息进入FIFO或定时堆时调用，同时维护msgSize
+static void MsgIndexInsertLocked(TFW_LooperContext *context, TFW_Message *msg)
+{
+    HandleIndexInsertLocked(context, msg);
+    LaneOf(context, msg)->msgSize++;
+    context->msgSize++;
+    if (context->msgSize > context->indexBucketCnt * MSG_INDEX_LOAD_FACTOR) {
+        MsgIndexGrowLocked(context);
+    }
+    TFW_ListTailInsert(MsgIndexBucket(context, msg->handler, msg->what), &msg->link.indexNode);
+}
+
+// 取队列中下一条消息：FIFO头与堆顶中(time, seq)较小者，O(1)
+static TFW_Message *PeekLaneLocked(const TFW_LooperLane *lane)
+{
+    TFW_Message *fifoHead = NULL;
+    if (!TFW_IsListEmpty(&lane->msgHead)) {
+        fifoHead = TFW_LIST_ENTRY(lane->msgHead.next, TFW_Message, link.node);
+    }
+    TFW_Message *heapTop = (lane->timerHeapSize > 0) ? lane->timerHeap[0] : NULL;
+    if (fifoHead == NULL) {
+        return heapTop;
+    }
+    if (heapTop == NULL) {
+        return fifoHead;
+    }
+    return MessageNodeBefore(heapTop, fifoHead) ? heapTop : fifoHead;
+}
+
+// 消息最晚的唤醒时刻：紧急消息准时，其余消息可推迟timerSlackUs
+static int64_t WakeTimeOf(const TFW_LooperContext *context, const TFW_Message *msg)
+{
+    if (msg->priority == TFW_MSG_PRIORITY_URGENT) {
+        return msg->time;
+    }
+    return msg->time + context->timerSlackUs;
+}
+
+// 下一次唤醒时刻：各队列队首最晚唤醒时刻的最小值，唤醒时分发所有已到期消息，
+// 使松弛窗口内的到期时间合并为一次唤醒
+static int64_t NextWakeTimeLocked(const TFW_LooperContext *context)
+{
+    int64_t wakeTime = TFW_LOOPER_POLL_FOREVER;
+    for (uint32_t i = 0; i < TFW_MSG_PRIORITY_MAX; i++) {
+        TFW_Message *head = PeekLaneLocked(&context->lanes[i]);
+        if (head == NULL) {
+            continue;
+        }
+        int64_t at = WakeTimeOf(context, head);
+        if (wakeTime == TFW_LOOPER_POLL_FOREVER || at < wakeTime) {
+            wakeTime = at;
+        }
+    }
+    return wakeTime;
+}
+
+// 按优先级选出下一条已到期的消息；低优先级队列被跳过达到预算后优先选它一次
+static TFW_Message *PickNextLocked(TFW_LooperContext *context, int64_t now)
+{
+    TFW_LooperLane *chosen = NULL;
+    TFW_Message *chosenMsg = NULL;
+    for (uint32_t i = 0; i < TFW_MSG_PRIORITY_MAX; i++) {
+        TFW_LooperLane *lane = &context->lanes[g_laneOrder[i]];
+        TFW_Message *head = PeekLaneLocked(lane);
+        if (head == NULL || head->time > now) {
+            continue;
+        }
+        if (chosen == NULL) {
+            chosen = lane;
+            chosenMsg = head;
+        } else if (lane->skipped >= LOOPER_LANE_STARVE_BUDGET) {
+            chosen = lane;
+            chosenMsg = head;
+            break;
+        }
+    }
+    if (chosen == NULL) {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < TFW_MSG_PRIORITY_MAX; i++) {
+        TFW_LooperLane *lane = &context->lanes[i];
+        if (lane == chosen) {
+            continue;
+        }
+        TFW_Message *head = PeekLaneLocked(lane);
+        if (head != NULL && head->time <= now) {
+            lane->skipped++;
+        }
+    }
+    chosen->skipped = 0;
+    return chosenMsg;
+}
+
+static void UnlinkLocked(TFW_LooperContext *context, TFW_Message *node)
+{
+    TFW_LooperLane *lane = LaneOf(context, node);
+    if (node->link.heapIndex != TIMER_HEAP_INVALID_INDEX) {
+        TimerHeapRemoveAt(lane, node->link.heapIndex);
+    } else {
+        TFW_ListDelete(&node->link.node);
+    }
+    TFW_ListDelete(&node->link.indexNode);
+    HandleIndexRemoveLocked(context, node);
+    lane->msgSize--;
+    context->msgSize--;
+}
+
+// ============================================================================
+// 零延时消息无锁队列
+// Lock-free MPSC queue for zero-delay messages
+// ============================================================================
+
+static void MpscInit(TFW_LooperContext *context)
+{
+    TFW_AtomicStorePtr(&context->mpscStub.link.next, NULL);
+    TFW_AtomicStorePtr(&context->mpscHead, &context->mpscStub);
+    context->mpscTail = &context->mpscStub;
+}
+
+static void MpscPush(TFW_LooperContext *context, TFW_Message *node)
+{
+    TFW_AtomicStorePtr(&node->link.next, NULL);
+    TFW_Message *prev = (TFW_Message *)TFW_AtomicExchangePtr(&context->mpscHead, node);
+    TFW_AtomicStorePtr(&prev->link.next, node);
+}
+
+// 整条已链接好的链一次入队，last->link.next须为NULL
+static void MpscPushChain(TFW_LooperContext *context, TFW_Message *first, TFW_Message *last)
+{
+    TFW_Message *prev = (TFW_Message *)TFW_AtomicExchangePtr(&context->mpscHead, last);
+    TFW_AtomicStorePtr(&prev->link.next, first);
+}
+
+// 持有lock时调用；生产者交换头指针后尚未链接完成时返回NULL
+static TFW_Message *MpscPopLocked(TFW_LooperContext *context)
+{
+    TFW_Message *tail = context->mpscTail;
+    TFW_Message *next = (TFW_Message *)TFW_AtomicLoadPtr(&tail->link.next);
+    if (tail == &context->mpscStub) {
+        if (next == NULL) {
+            return NULL;
+        }
+        context->mpscTail = next;
+        tail = next;
+        next = (TFW_Message *)TFW_AtomicLoadPtr(&next->link.next);
+    }
+    if (next != NULL) {
+        context->mpscTail = next;
+        return tail;
+    }
+    if (tail != (TFW_Message *)TFW_AtomicLoadPtr(&context->mpscHead)) {
+        return NULL;
+    }
+    MpscPush(context, &context->mpscStub);
+    next = (TFW_Message *)TFW_AtomicLoadPtr(&tail->link.next);
+    if (next != NULL) {
+        context->mpscTail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+// 队列中存在已入队或正在入队的节点
+static bool MpscHasPendingLocked(TFW_LooperContext *context)
+{
+    return TFW_AtomicLoadPtr(&context->mpscHead) != (void *)context->mpscTail;
+}
+
+// 将无锁队列中的消息转移到FIFO尾部，持有lock时调用
+static void AppendLocked(TFW_LooperContext *context, TFW_Message *node)
+{
+    node->link.seq = context->postSeq++;
+    TFW_ListTailInsert(&LaneOf(context, node)->msgHead, &node->link.node);
+    MsgIndexInsertLocked(context, node);
+}
+
+static void DrainMpscLocked(TFW_LooperContext *context)
+{
+    TFW_Message *node = NULL;
+    while ((node = MpscPopLocked(context)) != NULL) {
+        AppendLocked(context, node);
+    }
+}
+
+// 仅在looper线程确实挂起时才唤醒；epoll后端写eventfd，无需加锁
+static void WakeLooperIfParked(TFW_LooperContext *context)
+{
+    if (TFW_AtomicLoad32(&context->parked) == 0) {
+        return;
+    }
+    if (context->poller != NULL) {
+        TFW_LooperPollerWakeup(context->poller);
+        return;
+    }
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return;
+    }
+    TFW_Cond_Signal(&context->cond);
+    (void)TFW_Mutex_Unlock(&context->lock);
+}
+
+// 持有lock时唤醒挂起的looper线程
+static void WakeParkedLocked(TFW_LooperContext *context)
+{
+    if (TFW_AtomicLoad32(&context->parked) == 0) {
+        return;
+    }
+    if (context->poller != NULL) {
+        TFW_LooperPollerWakeup(context->poller);
+    } else {
+        TFW_Cond_Signal(&context->cond);
+    }
+}
+
+// 持有lock时为新入队的消息唤醒looper线程；挂起的唤醒时刻不晚于该消息的最晚唤醒时刻时无需唤醒
+static void WakeParkedForMessageLocked(TFW_LooperContext *context, const TFW_Message *msg)
+{
+    if (context->parkDeadline != TFW_LOOPER_POLL_FOREVER && context->parkDeadline <= WakeTimeOf(context, msg)) {
+        return;
+    }
+    WakeParkedLocked(context);
+}
+
+// ============================================================================
+// 描述符监听（epoll后端）
+// File descriptor watching (epoll backend)
+// ============================================================================
+
+static TFW_LooperFdEntry *FindFdEntryLocked(TFW_LooperContext *context, int32_t fd)
+{
+    TFW_ListNode *item = NULL;
+    TFW_LIST_FOR_EACH(item, &context->fdEntries) {
+        TFW_LooperFdEntry *entry = TFW_LIST_ENTRY(item, TFW_LooperFdEntry, node);
+        if (entry->fd == fd) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void ReleaseFdEntryLocked(TFW_LooperFdEntry *entry)
+{
+    if (--entry->refs == 0) {
+        TFW_Free(entry);
+    }
+}
+
+// 就绪消息执行完毕或被移除后重新启用描述符
+static void FreeFdEventMessage(TFW_Message *msg)
+{
+    TFW_LooperFdEntry *entry = (TFW_LooperFdEntry *)msg->obj;
+    TFW_LooperContext *context = entry->context;
+    (void)TFW_Mutex_Lock(&context->fdLock);
+    if (!entry->removed) {
+        (void)TFW_LooperPollerRearm(context->poller, entry->fd, entry->events);
+    }
+    ReleaseFdEntryLocked(entry);
+    (void)TFW_Mutex_Unlock(&context->fdLock);
+    msg->FreeMessage = NULL;
+    FreeTFWMsg(msg);
+}
+
+// 将就绪事件转换为即时消息；描述符为单次触发，消息释放前不会重复上报，因此不计入容量限制
+static void PostFdEventsLocked(TFW_LooperContext *context, const TFW_LooperPollEvent *events, int32_t count)
+{
+    int64_t now = UptimeMicros();
+    for (int32_t i = 0; i < count; i++) {
+        (void)TFW_Mutex_Lock(&context->fdLock);
+        TFW_LooperFdEntry *entry = FindFdEntryLocked(context, events[i].fd);
+        if (entry != NULL) {
+            entry->refs++;
+        }
+        (void)TFW_Mutex_Unlock(&context->fdLock);
+        if (entry == NULL) {
+            continue;
+        }
+        TFW_Message *msg = TFW_MallocMessage();
+        if (msg == NULL) {
+            (void)TFW_Mutex_Lock(&context->fdLock);
+            (void)TFW_LooperPollerRearm(context->poller, entry->fd, entry->events);
+            ReleaseFdEntryLocked(entry);
+            (void)TFW_Mutex_Unlock(&context->fdLock);
+            continue;
+        }
+        msg->what = TFW_LOOPER_WHAT_FD_EVENT;
+        msg->arg1 = (uint64_t)events[i].fd;
+        msg->arg2 = events[i].events;
+        msg->obj = entry;
+        msg->handler = entry->handler;
+        msg->FreeMessage = FreeFdEventMessage;
+        msg->time = now;
+        TFW_ListInit(&msg->link.node);
+        msg->link.heapIndex = TIMER_HEAP_INVALID_INDEX;
+        (void)TFW_LooperStatsOnPost(&context->stats, 1, 0);
+        TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_POST, msg, now);
+        AppendLocked(context, msg);
+    }
+}
+
+// 持有lock时轮询描述符，等待期间释放lock；deadline为0时不等待
+static void PollLocked(TFW_LooperContext *context, int64_t deadline)
+{
+    TFW_LooperPollEvent events[LOOPER_DISPATCH_BATCH_MAX];
+    (void)TFW_Mutex_Unlock(&context->lock);
+    int32_t count = TFW_LooperPollerWait(context->poller, deadline, events, LOOPER_DISPATCH_BATCH_MAX);
+    (void)TFW_Mutex_Lock(&context->lock);
+    if (count > 0) {
+        PostFdEventsLocked(context, events, count);
+    }
+}
+
+static void MicrosToSysTime(int64_t time, TFW_SysTime *tv)
+{
+    tv->sec = time / TIME_THOUSANDS_MULTIPLIER / TIME_THOUSANDS_MULTIPLIER;
+    tv->nsec = (time % (TIME_THOUSANDS_MULTIPLIER * TIME_THOUSANDS_MULTIPLIER)) * 1000; // 转换为纳秒
+}
+
+// 持有lock时唤醒因队列已满而阻塞的投递线程
+static void NotifyNotFullLocked(TFW_LooperContext *context)
+{
+    if (TFW_AtomicLoad32(&context->notFullWaiters) != 0) {
+        TFW_Cond_Broadcast(&context->condNotFull);
+    }
+}
+
+// 持有lock时挂起looper线程直到deadline（TFW_LOOPER_POLL_FOREVER表示无限等待）；
+// 挂起前再次检查无锁队列，避免丢失唤醒
+static void ParkLocked(TFW_LooperContext *context, int64_t deadline)
+{
+    TFW_AtomicStore32(&context->parked, 1);
+    context->parkDeadline = deadline;
+    bool idle = !MpscHasPendingLocked(context) && context->stop == 0;
+    if (context->poller != NULL) {
+        PollLocked(context, idle ? deadline : 0);
+    } else if (idle) {
+        TFW_SysTime tv;
+        MicrosToSysTime(deadline, &tv);
+        TFW_Cond_Wait(&context->cond, &context->lock, (deadline == TFW_LOOPER_POLL_FOREVER) ? NULL : &tv);
+    }
+    context->parkDeadline = TFW_LOOPER_POLL_FOREVER;
+    TFW_AtomicStore32(&context->parked, 0);
+    if (idle) {
+        TFW_LooperStatsOnWakeup(&context->stats);
+    }
+}
+
+static void DumpMessage(const TFW_Message *msg, uint32_t index)
+{
+    TFW_LOGD_UTILS("Message[%u] - What: %d, Time: %lld, Handler: %s",
+                    index, msg->what, msg->time,
+                    (msg->handler && msg->handler->name) ? msg->handler->name : "null");
+}
+
+static void DumpLooperLocked(const TFW_Looper *looper)
+{
+    if (looper == NULL || looper->context == NULL) {
+        TFW_LOGE_UTILS("Invalid looper or context");
+        return;
+    }
+
+    const TFW_LooperContext *context = looper->context;
+    if (context->batchCount != 0) {
+        TFW_LOGD_UTILS("Dispatching batch - count: %u", context->batchCount);
+    }
+
+    // 按分发顺序遍历各优先级队列并打印信息（先即时消息，再按堆数组顺序打印延时消息）
+    uint32_t count = 0;
+    for (uint32_t lane = 0; lane < TFW_MSG_PRIORITY_MAX; lane++) {
+        const TFW_LooperLane *queue = &context->lanes[g_laneOrder[lane]];
+        TFW_ListNode *item = NULL;
+        TFW_LIST_FOR_EACH(item, &queue->msgHead) {
+            if (count >= MAX_LOOPER_PRINT_CNT) {
+                break;
+            }
+            DumpMessage(TFW_LIST_ENTRY(item, TFW_Message, link.node), count++);
+        }
+        for (uint32_t i = 0; i < queue->timerHeapSize && count < MAX_LOOPER_PRINT_CNT; i++) {
+            DumpMessage(queue->timerHeap[i], count++);
+        }
+    }
+    // 避免打印过多信息
+    if (count >= MAX_LOOPER_PRINT_CNT && context->msgSize > count) {
+        TFW_LOGD_UTILS("... and more messages");
+    }
+}
+
+void DumpLooper(const TFW_Looper *looper)
+{
+    if (looper == NULL || looper->context == NULL) {
+        TFW_LOGE_UTILS("Invalid looper or context");
+        return;
+    }
+
+    TFW_LooperContext *context = looper->context;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        TFW_LOGE_UTILS("Failed to lock looper mutex");
+        return;
+    }
+
+    DrainMpscLocked(context);
+    DumpLooperLocked(looper);
+
+    (void)TFW_Mutex_Unlock(&context->lock);
+}
+
+int32_t TFW_LooperGetStats(const TFW_Looper *looper, TFW_LooperStats *stats)
+{
+    if (looper == NULL || looper->context == NULL || stats == NULL) {
+        TFW_LOGE_UTILS("invalid looper or stats");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    TFW_LooperContext *context = looper->context;
+    TFW_LooperStatsSnapshot(&context->stats, stats);
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return TFW_SUCCESS;
+    }
+    DrainMpscLocked(context);
+    for (uint32_t i = 0; i < TFW_MSG_PRIORITY_MAX; i++) {
+        stats->laneMsgSize[i] = context->lanes[i].msgSize;
+    }
+    (void)TFW_Mutex_Unlock(&context->lock);
+    return TFW_SUCCESS;
+}
+
+uint32_t TFW_LooperTraceSnapshot(const TFW_Looper *looper, TFW_LooperTraceEvent *events, uint32_t maxCnt)
+{
+    if (looper == NULL || looper->context == NULL || events == NULL) {
+        TFW_LOGE_UTILS("invalid looper or events");
+        return 0;
+    }
+    return TFW_LooperTraceCopy(&looper->context->trace, events, maxCnt);
+}
+
+const char *TFW_LooperTraceTypeName(TFW_LooperTraceType type)
+{
+    static const char *names[TFW_LOOPER_TRACE_MAX] = {
+        "POST", "DISPATCH", "HANDLE_START", "HANDLE_END", "REMOVE"
+    };
+    return ((uint32_t)type < TFW_LOOPER_TRACE_MAX) ? names[type] : "UNKNOWN";
+}
+
+void TFW_LooperTraceDump(const TFW_Looper *looper)
+{
+    if (looper == NULL || looper->context == NULL) {
+        TFW_LOGE_UTILS("Invalid looper or context");
+        return;
+    }
+    TFW_LooperTraceEvent *events =
+        (TFW_LooperTraceEvent *)TFW_Malloc(sizeof(TFW_LooperTraceEvent) * TFW_LOOPER_TRACE_CAPACITY);
+    if (events == NULL) {
+        TFW_LOGE_UTILS("trace dump malloc fail");
+        return;
+    }
+    uint32_t count = TFW_LooperTraceCopy(&looper->context->trace, events, TFW_LOOPER_TRACE_CAPACITY);
+    TFW_LOGI_UTILS("trace dump. name=%s, count=%u", looper->context->name, count);
+    for (uint32_t i = 0; i < count; i++) {
+        const TFW_LooperTraceEvent *event = &events[i];
+        TFW_LOGI_UTILS("trace[%u] time=%lld %s handler=%s what=%d arg1=%llu", i, (long long)event->timeUs,
+            TFW_LooperTraceTypeName(event->type),
+            (event->handler != NULL && event->handler->name != NULL) ? event->handler->name : "null",
+            event->what, (unsigned long long)event->arg1);
+    }
+    TFW_Free(events);
+}
+
+// ... existing code ...
+
+static int32_t EnqueueLocked(TFW_LooperContext *context, TFW_Message *msg);
+
+// 一次性投递路径清除重复字段，调用者自行分配的消息可能未清零
+static void ClearRepeat(TFW_Message *msg)
+{
+    msg->link.periodUs = 0;
+    msg->link.repeatState = MESSAGE_REPEAT_NONE;
+}
+
+// 执行完毕后计算重复消息的下次到期时刻，只由执行该消息的线程调用
+static void AdvanceRepeating(TFW_LooperContext *context, TFW_Message *msg, int64_t end)
+{
+    int64_t period = (int64_t)msg->link.periodUs;
+    msg->link.missedPeriods = 0;
+    if ((msg->link.repeatFlags & TFW_LOOPER_REPEAT_FIXED_DELAY) != 0) {
+        msg->time = end + period;
+        return;
+    }
+    int64_t next = msg->time + period;
+    if (next > end) {
+        msg->time = next;
+        return;
+    }
+    // 执行超时：最近一个已到期的周期立即执行，更早的周期跳过
+    int64_t missed = (end - next) / period;
+    msg->time = next + missed * period;
+    msg->link.missedPeriods = (missed > UINT32_MAX) ? UINT32_MAX : (uint32_t)missed;
+    TFW_LooperStatsOnMissed(&context->stats, msg->link.missedPeriods);
+}
+
+// 持有lock时将执行完毕的重复消息重新放入定时堆；返回false表示消息应由调用者释放
+static bool RearmRepeatingLocked(TFW_LooperContext *context, TFW_Message *msg)
+{
+    if (msg->link.repeatState != MESSAGE_REPEAT_RUNNING || context->stop == 1 ||
+        TFW_AtomicLoad32(&msg->link.state) == MESSAGE_STATE_CANCELLED) {
+        return false;
+    }
+    // 重复消息已通过准入，重新放入时不受容量限制
+    (void)TFW_LooperStatsOnPost(&context->stats, 1, 0);
+    if (EnqueueLocked(context, msg) != TFW_SUCCESS) {
+        TFW_LOGE_UTILS("rearm repeating message fail. name=%s, what=%d", context->name, msg->what);
+        TFW_LooperStatsOnPostFailed(&context->stats, 1);
+        return false;
+    }
+    msg->link.repeatState = MESSAGE_REPEAT_ARMED;
+    return true;
+}
+
+// 持有lock时取下已执行完毕的批次交由调用者在锁外释放，重复消息重新放入定时堆
+static void RetireBatchLocked(TFW_LooperContext *context, TFW_Message **done, uint32_t *doneCount)
+{
+    uint32_t freeCount = 0;
+    for (uint32_t i = 0; i < context->batchCount; i++) {
+        TFW_Message *msg = context->batch[i];
+        HandleIndexRemoveLocked(context, msg);
+        if (!RearmRepeatingLocked(context, msg)) {
+            done[freeCount++] = msg;
+        }
+    }
+    *doneCount = freeCount;
+    context->batchCount = 0;
+    // 上一批次已执行完毕，stats.depth已减少
+    NotifyNotFullLocked(context);
+}
+
+// 持有lock时取下上一批次交由调用者在锁外释放，并将已到期消息移入新批次
+// 并发looper的到期消息放入handoff，由调用者在锁外提交到执行器
+static uint32_t FillBatchLocked(TFW_LooperContext *context, TFW_Message **done, uint32_t *doneCount,
+    TFW_Message **handoff)
+{
+    RetireBatchLocked(context, done, doneCount);
+    if (context->stop == 1) {
+        return 0;
+    }
+
+    DrainMpscLocked(context);
+    TFW_Message **ready = (context->executor != NULL) ? handoff : context->batch;
+    uint32_t count = 0;
+    int64_t now = UptimeMicros();
+    TFW_Message *next = NULL;
+    while (count < LOOPER_DISPATCH_BATCH_MAX && (next = PickNextLocked(context, now)) != NULL) {
+        UnlinkLocked(context, next);
+        TFW_AtomicStore32(&next->link.state, MESSAGE_STATE_QUEUED);
+        if (next->link.repeatState == MESSAGE_REPEAT_ARMED) {
+            next->link.repeatState = MESSAGE_REPEAT_RUNNING;
+        }
+        // 提交到执行器的一次性消息已无法取消，不再保留句柄
+        if (context->executor == NULL || next->link.periodUs != 0) {
+            HandleIndexInsertLocked(context, next);
+        }
+        TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_DISPATCH, next, now);
+        ready[count++] = next;
+    }
+    if (context->executor == NULL) {
+        context->batchCount = count;
+    }
+    return count;
+}
+
+// 认领批次中的消息；若移除操作正在匹配，借助lock等待其完成
+static bool ClaimBatchMessage(TFW_LooperContext *context, TFW_Message *msg)
+{
+    for (;;) {
+        if (TFW_AtomicCompareAndSwap32(&msg->link.state, MESSAGE_STATE_QUEUED, MESSAGE_STATE_DISPATCHING)) {
+            return true;
+        }
+        if (TFW_AtomicLoad32(&msg->link.state) == MESSAGE_STATE_CANCELLED) {
+            return false;
+        }
+        (void)TFW_Mutex_Lock(&context->lock);
+        (void)TFW_Mutex_Unlock(&context->lock);
+    }
+}
+
+// start为本条消息开始执行的时刻，返回执行结束的时刻供下一条消息复用，每条消息只读一次时钟
+static int64_t DispatchMessage(const TFW_Looper *looper, TFW_Message *msg, int64_t start)
+{
+    TFW_LooperContext *context = looper->context;
+    TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_HANDLE_START, msg, start);
+    if (msg->handler != NULL && msg->handler->HandleMessage != NULL) {
+        msg->handler->HandleMessage(msg);
+    }
+    int64_t end = UptimeMicros();
+    TFW_LooperStatsOnDispatch(&context->stats, msg->handler, start - msg->time, end - start);
+    TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_HANDLE_END, msg, end);
+    if (msg->link.periodUs != 0) {
+        AdvanceRepeating(context, msg, end);
+    }
+    return end;
+}
+
+#define MESSAGE_FROM_TASK(task) \
+    ((TFW_Message *)((char *)(task) - offsetof(TFW_Message, link.task)))
+
+// 执行器任务结束时对context的最后一次访问：非最后一个任务无锁递减，最后一个任务在lock下归零并通知销毁方，
+// 保证TFW_DestroyLooper观察到归零时工作线程已不再访问context
+static void ExecutorTaskDone(TFW_LooperContext *context)
+{
+    int32_t cnt = TFW_AtomicLoad32(&context->executorTasks);
+    while (cnt > 1) {
+        if (TFW_AtomicCompareAndSwap32(&context->executorTasks, cnt, cnt - 1)) {
+            return;
+        }
+        cnt = TFW_AtomicLoad32(&context->executorTasks);
+    }
+    (void)TFW_Mutex_Lock(&context->lock);
+    if (TFW_AtomicDec32(&context->executorTasks) == 0 && context->stop == 1) {
+        TFW_Cond_Broadcast(&context->condRunning);
+    }
+    (void)TFW_Mutex_Unlock(&context->lock);
+}
+
+static void RunMessageTask(TFW_ExecutorTask *task)
+{
+    TFW_Message *msg = MESSAGE_FROM_TASK(task);
+    TFW_LooperContext *context = msg->link.owner;
+    int64_t start = UptimeMicros();
+    TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_HANDLE_START, msg, start);
+    if (msg->handler != NULL && msg->handler->HandleMessage != NULL) {
+        msg->handler->HandleMessage(msg);
+    }
+    int64_t end = UptimeMicros();
+    TFW_LooperStatsOnDispatch(&context->stats, msg->handler, start - msg->time, end - start);
+    TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_HANDLE_END, msg, end);
+    bool rearmed = false;
+    if (msg->link.periodUs != 0) {
+        AdvanceRepeating(context, msg, end);
+        (void)TFW_Mutex_Lock(&context->lock);
+        HandleIndexRemoveLocked(context, msg);
+        rearmed = RearmRepeatingLocked(context, msg);
+        if (rearmed) {
+            WakeParkedForMessageLocked(context, msg);
+        }
+        (void)TFW_Mutex_Unlock(&context->lock);
+    }
+    if (!rearmed) {
+        FreeTFWMsg(msg);
+    }
+    if (TFW_AtomicLoad32(&context->notFullWaiters) != 0 && TFW_Mutex_Lock(&context->lock) == 0) {
+        TFW_Cond_Broadcast(&context->condNotFull);
+        (void)TFW_Mutex_Unlock(&context->lock);
+    }
+    ExecutorTaskDone(context);
+}
+
+// 消息所有权转交执行器，执行完毕后由工作线程释放
+static void SubmitMessageToExecutor(TFW_LooperContext *context, TFW_Message *msg)
+{
+    msg->link.task.Run = RunMessageTask;
+    msg->link.owner = context;
+    (void)TFW_AtomicInc32(&context->executorTasks);
+    if (TFW_ExecutorSubmit(context->executor, &msg->link.task) != TFW_SUCCESS) {
+        TFW_LOGE_UTILS("submit message to executor failed. name=%s, what=%d", context->name, msg->what);
+        TFW_LooperStatsOnRemove(&context->stats, 1);
+        if (msg->link.periodUs != 0) {
+            (void)TFW_Mutex_Lock(&context->lock);
+            HandleIndexRemoveLocked(context, msg);
+            (void)TFW_Mutex_Unlock(&context->lock);
+        }
+        FreeTFWMsg(msg);
+        ExecutorTaskDone(context);
+    }
+}
+
+// ============================================================================
+// 空闲回调
+// Idle handlers
+// ============================================================================
+
+static bool IdleDueLocked(const TFW_LooperContext *context)
+{
+    if (context->idleHandlerCnt == 0) {
+        return false;
+    }
+    if (context->idlePending) {
+        return true;
+    }
+    return context->idleDeadline != TFW_LOOPER_POLL_FOREVER && UptimeMicros() >= context->idleDeadline;
+}
+
+static bool RemoveIdleEntryLocked(TFW_LooperContext *context, TFW_LooperIdleFunc func, void *arg)
+{
+    for (uint32_t i = 0; i < context->idleHandlerCnt; i++) {
+        if (context->idleHandlers[i].func == func && context->idleHandlers[i].arg == arg) {
+            context->idleHandlers[i] = context->idleHandlers[--context->idleHandlerCnt];
+            return true;
+        }
+    }
+    return false;
+}
+
+// 持有lock时执行空闲回调，执行期间释放lock；回调期间投递的消息在下一轮循环中处理。
+// 由忙转闲时执行全部回调，持续空闲时只执行请求的间隔已到的回调
+static void RunIdleHandlersLocked(TFW_LooperContext *context)
+{
+    TFW_LooperIdleEntry pending[TFW_LOOPER_IDLE_HANDLER_MAX];
+    int32_t results[TFW_LOOPER_IDLE_HANDLER_MAX];
+    bool all = context->idlePending;
+    int64_t now = UptimeMicros();
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < context->idleHandlerCnt; i++) {
+        TFW_LooperIdleEntry *entry = &context->idleHandlers[i];
+        if (all || (entry->deadline != TFW_LOOPER_POLL_FOREVER && entry->deadline <= now)) {
+            pending[count++] = *entry;
+        }
+    }
+    context->idlePending = false;
+    (void)TFW_Mutex_Unlock(&context->lock);
+    for (uint32_t i = 0; i < count; i++) {
+        results[i] = pending[i].func(pending[i].arg);
+    }
+    now = UptimeMicros();
+    (void)TFW_Mutex_Lock(&context->lock);
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (results[i] == TFW_LOOPER_IDLE_REMOVE) {
+            (void)RemoveIdleEntryLocked(context, pending[i].func, pending[i].arg);
+            continue;
+        }
+        for (uint32_t j = 0; j < context->idleHandlerCnt; j++) {
+            TFW_LooperIdleEntry *entry = &context->idleHandlers[j];
+            if (entry->func == pending[i].func && entry->arg == pending[i].arg) {
+                entry->deadline = (results[i] > 0) ?
+                    now + (int64_t)results[i] * TIME_THOUSANDS_MULTIPLIER : TFW_LOOPER_POLL_FOREVER;
+                break;
+            }
+        }
+    }
+    int64_t deadline = TFW_LOOPER_POLL_FOREVER;
+    for (uint32_t i = 0; i < context->idleHandlerCnt; i++) {
+        int64_t at = context->idleHandlers[i].deadline;
+        if (at != TFW_LOOPER_POLL_FOREVER && (deadline == TFW_LOOPER_POLL_FOREVER || at < deadline)) {
+            deadline = at;
+        }
+    }
+    context->idleDeadline = deadline;
+}
+
+// 执行一轮循环：每次加锁取走所有已到期消息（至多一个批次），执行与释放均不再加锁；
+// 无事可做时挂起，至多到waitUntil。返回执行的消息数，looper已停止时返回-1
+static int32_t LoopIterate(const TFW_Looper *looper, int64_t waitUntil)
+{
+    TFW_LooperContext *context = looper->context;
+    TFW_Message *done[LOOPER_DISPATCH_BATCH_MAX];
+    TFW_Message *handoff[LOOPER_DISPATCH_BATCH_MAX];
+    uint32_t doneCount = 0;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return -1;
+    }
+    uint32_t count = FillBatchLocked(context, done, &doneCount, handoff);
+    bool stop = (context->stop == 1);
+    if (count != 0) {
+        context->idlePending = true;
+    }
+    // 上一批次释放完毕后才挂起，避免消息释放被延迟到下次唤醒；请求退出时不再挂起
+    if (count == 0 && doneCount == 0 && !stop && TFW_AtomicLoad32(&context->quit) == 0) {
+        int64_t deadline = NextWakeTimeLocked(context);
+        if (context->idleDeadline != TFW_LOOPER_POLL_FOREVER &&
+            (deadline == TFW_LOOPER_POLL_FOREVER || context->idleDeadline < deadline)) {
+            deadline = context->idleDeadline;
+        }
+        if (waitUntil != TFW_LOOPER_POLL_FOREVER && (deadline == TFW_LOOPER_POLL_FOREVER || waitUntil < deadline)) {
+            deadline = waitUntil;
+        }
+        if (IdleDueLocked(context)) {
+            // 挂起前执行空闲回调，随后重新检查队列
+            RunIdleHandlersLocked(context);
+        } else if (deadline == waitUntil && waitUntil != TFW_LOOPER_POLL_FOREVER && waitUntil <= UptimeMicros()) {
+            // 调用者的等待时限已到，不再挂起，只不阻塞地检查一次描述符
+            if (context->poller != NULL) {
+                PollLocked(context, 0);
+            }
+        } else if (deadline == TFW_LOOPER_POLL_FOREVER) {
+            TFW_LOGD_UTILS("LoopTask wait msg list empty. name=%s", context->name);
+            // 等待新消息，替代轮询等待
+            ParkLocked(context, TFW_LOOPER_POLL_FOREVER);
+        } else {
+            // 定时等待，在下一条消息到期、下一次空闲回调或waitUntil时自动唤醒
+            ParkLocked(context, deadline);
+        }
+    } else if (context->poller != NULL && !stop) {
+        // 忙碌时每个批次不阻塞地检查一次描述符，避免就绪事件被持续的消息流饿死
+        PollLocked(context, 0);
+    }
+    (void)TFW_Mutex_Unlock(&context->lock);
+
+    for (uint32_t i = 0; i < doneCount; i++) {
+        FreeTFWMsg(done[i]);
+    }
+    if (stop) {
+        TFW_LOGI_UTILS("LoopTask stop is 1. name=%s", context->name);
+        return -1;
+    }
+    int64_t now = (count != 0) ? UptimeMicros() : 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (context->executor != NULL) {
+            SubmitMessageToExecutor(context, handoff[i]);
+            continue;
+        }
+        TFW_Message *msg = context->batch[i];
+        if (ClaimBatchMessage(context, msg)) {
+            now = DispatchMessage(looper, msg, now);
+        }
+    }
+    return (int32_t)count;
+}
+
+static void *LoopTask(void *arg)
+{
+    TFW_Looper *looper = (TFW_Looper *)arg;
+    TFW_LooperContext *context = looper->context;
+    if (context == NULL) {
+        TFW_LOGE_UTILS("loop context is NULL");
+        return NULL;
+    }
+
+    TFW_LOGD_UTILS("LoopTask running. name=%s", context->name);
+
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        TFW_LOGE_UTILS("lock failed");
+        return NULL;
+    }
+    context->running = 1;
+    context->threadId = TFW_GetThreadId();
+    (void)TFW_Mutex_Unlock(&context->lock);
+
+    for (;;) {
+        if (LoopIterate(looper, TFW_LOOPER_POLL_FOREVER) < 0) {
+            break;
+        }
+    }
+    (void)TFW_Mutex_Lock(&context->lock);
+    context->running = 0;
+    TFW_LOGI_UTILS("LoopTask running is 0. name=%s", context->name);
+    // 使用条件变量广播通知，优化TFW_DestroyLooper中的等待逻辑
+    TFW_Cond_Broadcast(&context->condRunning);
+    (void)TFW_Mutex_Unlock(&context->lock);
+    return NULL;
+}
+
+static int32_t StartNewLooperThread(TFW_Looper *looper, const TFW_ThreadAttr *threadAttr)
+{
+    TFW_ThreadAttr attr;
+    if (threadAttr != NULL) {
+        attr = *threadAttr;
+    } else {
+        TFW_ThreadAttr_Init(&attr);
+    }
+    attr.name = looper->context->name;
+
+    TFW_Thread_t tid;
+    int32_t ret = TFW_Thread_Create(&tid, &attr, LoopTask, looper);
+    if (ret != TFW_SUCCESS) {
+        TFW_LOGE_UTILS("Init LoopTask Thread failed");
+        return ret;
+    }
+
+    TFW_LOGI_UTILS("loop thread creating. name=%s", looper->context->name);
+    return TFW_SUCCESS;
+}
+
+// 创建looper线程，已创建或已停止时直接返回；running在创建线程前置1，
+// 保证线程尚未运行时TFW_DestroyLooper也会等待其退出
+static int32_t EnsureLooperStarted(TFW_LooperContext *context)
+{
+    if (TFW_AtomicLoad32(&context->started) != 0) {
+        return TFW_SUCCESS;
+    }
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return TFW_ERROR_LOCK_FAILED;
+    }
+    int32_t ret = TFW_SUCCESS;
+    if (context->stop == 1) {
+        ret = TFW_ERROR_LOOPER_ERROR;
+    } else if (TFW_AtomicLoad32(&context->started) == 0) {
+        context->running = 1;
+        ret = StartNewLooperThread(context->looper, &context->threadAttr);
+        if (ret == TFW_SUCCESS) {
+            TFW_AtomicStore32(&context->started, 1);
+        } else {
+            context->running = 0;
+        }
+    }
+    (void)TFW_Mutex_Unlock(&context->lock);
+    return ret;
+}
+
+static int32_t PostMessageAtTimeParamVerify(const TFW_Looper *looper, TFW_Message *msgPost)
+{
+    if (msgPost == NULL) {
+        TFW_LOGE_UTILS("the msgPost param is null.");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+
+    if (looper == NULL) {
+        TFW_LOGE_UTILS("the looper param is null.");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+
+    if (msgPost->handler == NULL) {
+        TFW_LOGE_UTILS("[%s] msg handler is null", looper->context->name);
+        return TFW_ERROR_LOOPER_ERROR;
+    }
+
+    return TFW_SUCCESS;
+}
+
+// ============================================================================
+// 容量与背压
+// Capacity and backpressure
+// ============================================================================
+
+// 丢弃最早消息时的候选：最低优先级非空队列中最早到期的消息
+static TFW_Message *PickVictimLocked(const TFW_LooperContext *context)
+{
+    for (uint32_t i = TFW_MSG_PRIORITY_MAX; i > 0; i--) {
+        TFW_Message *head = PeekLaneLocked(&context->lanes[g_laneOrder[i - 1]]);
+        if (head != NULL) {
+            return head;
+        }
+    }
+    return NULL;
+}
+
+static int32_t WaitForSlotLocked(TFW_LooperContext *context)
+{
+    if (context->threadId == TFW_GetThreadId()) {
+        // looper线程阻塞等待自己腾出空位会死锁
+        TFW_LooperStatsOnReject(&context->stats);
+        return TFW_ERROR_QUEUE_FULL;
+    }
+    TFW_LooperStatsOnBlock(&context->stats);
+    TFW_SysTime deadline;
+    if (context->blockTimeoutMs != 0) {
+        MicrosToSysTime(UptimeMicros() + (int64_t)context->blockTimeoutMs * TIME_THOUSANDS_MULTIPLIER, &deadline);
+    }
+    (void)TFW_AtomicInc32(&context->notFullWaiters);
+    int32_t ret = TFW_SUCCESS;
+    while (!TFW_LooperStatsOnPost(&context->stats, 1, context->capacity)) {
+        if (context->stop == 1) {
+            ret = TFW_ERROR_LOOPER_ERROR;
+            break;
+        }
+        int32_t waitRet = TFW_Cond_Wait(&context->condNotFull, &context->lock,
+            (context->blockTimeoutMs != 0) ? &deadline : NULL);
+        if (waitRet == TFW_SUCCESS) {
+            continue;
+        }
+        if (!TFW_LooperStatsOnPost(&context->stats, 1, context->capacity)) {
+            ret = (waitRet == TFW_ERROR_TIMEOUT) ? TFW_ERROR_TIMEOUT : TFW_ERROR;
+        }
+        break;
+    }
+    (void)TFW_AtomicDec32(&context->notFullWaiters);
+    if (context->stop == 1) {
+        TFW_Cond_Broadcast(&context->condRunning);
+    }
+    return ret;
+}
+
+// 持有lock时为一条新消息占用容量，成功时消息已计入stats.depth
+// DROP_OLDEST丢弃的消息挂到victims上，由调用者在锁外释放；BLOCK等待期间会临时释放lock
+static int32_t AdmitLocked(TFW_LooperContext *context, TFW_ListNode *victims)
+{
+    if (TFW_LooperStatsOnPost(&context->stats, 1, context->capacity)) {
+        return TFW_SUCCESS;
+    }
+    switch (context->fullPolicy) {
+        case TFW_LOOPER_FULL_BLOCK:
+            return WaitForSlotLocked(context);
+        case TFW_LOOPER_FULL_DROP_OLDEST:
+            DrainMpscLocked(context);
+            do {
+                TFW_Message *victim = PickVictimLocked(context);
+                if (victim == NULL) {
+                    // 排队的消息都已移入分发批次，无可丢弃的消息，暂时超出容量
+                    (void)TFW_LooperStatsOnPost(&context->stats, 1, 0);
+                    break;
+                }
+                UnlinkLocked(context, victim);
+                TFW_LooperStatsOnDrop(&context->stats, true);
+                TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_REMOVE, victim, UptimeMicros());
+                TFW_ListTailInsert(victims, &victim->link.node);
+            } while (!TFW_LooperStatsOnPost(&context->stats, 1, context->capacity));
+            return TFW_SUCCESS;
+        case TFW_LOOPER_FULL_DROP_NEWEST:
+            TFW_LooperStatsOnDrop(&context->stats, false);
+            return TFW_ERROR_MSG_DROPPED;
+        default:
+            TFW_LooperStatsOnReject(&context->stats);
+            return TFW_ERROR_QUEUE_FULL;
+    }
+}
+
+static void FreeVictims(TFW_ListNode *victims)
+{
+    TFW_ListNode *item = NULL;
+    TFW_ListNode *nextItem = NULL;
+    TFW_LIST_FOR_EACH_SAFE(item, nextItem, victims) {
+        TFW_Message *msg = TFW_LIST_ENTRY(item, TFW_Message, link.node);
+        TFW_ListDelete(&msg->link.node);
+        FreeTFWMsg(msg);
+    }
+}
+
+// 无锁投递路径的容量检查：未满时只做一次CAS，已满时才加锁按策略处理
+static int32_t Admit(TFW_LooperContext *context)
+{
+    if (TFW_LooperStatsOnPost(&context->stats, 1, context->capacity)) {
+        return TFW_SUCCESS;
+    }
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return TFW_ERROR_LOCK_FAILED;
+    }
+    TFW_LIST_HEAD(victims);
+    int32_t ret = AdmitLocked(context, &victims);
+    (void)TFW_Mutex_Unlock(&context->lock);
+    FreeVictims(&victims);
+    return ret;
+}
+
+// 将消息按时间放入FIFO或定时堆并加入索引，调用者已完成容量检查
+static int32_t EnqueueLocked(TFW_LooperContext *context, TFW_Message *msg)
+{
+    TFW_ListInit(&msg->link.node);
+    msg->link.heapIndex = TIMER_HEAP_INVALID_INDEX;
+    msg->link.seq = context->postSeq++;
+    TFW_LooperLane *lane = LaneOf(context, msg);
+    if (msg->time <= UptimeMicros()) {
+        // 已到期的消息直接追加到FIFO尾部，O(1)
+        TFW_ListTailInsert(&lane->msgHead, &msg->link.node);
+    } else if (TimerHeapPush(lane, msg) != TFW_SUCCESS) {
+        return TFW_ERROR_MALLOC_ERR;
+    }
+    MsgIndexInsertLocked(context, msg);
+    return TFW_SUCCESS;
+}
+
+static int32_t PostMessageAtTime(const TFW_Looper *looper, TFW_Message *msgPost)
+{
+    int32_t ret = PostMessageAtTimeParamVerify(looper, msgPost);
+    if (ret == TFW_SUCCESS) {
+        ret = EnsureLooperStarted(looper->context);
+    }
+    if (ret != TFW_SUCCESS) {
+        FreeTFWMsg(msgPost);
+        return ret;
+    }
+
+    msgPost->link.mergeKind = MESSAGE_MERGE_NONE;
+    TFW_LooperContext *context = looper->context;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        FreeTFWMsg(msgPost);
+        return TFW_ERROR_LOCK_FAILED;
+    }
+    TFW_LIST_HEAD(victims);
+    ret = (context->stop == 1) ? TFW_ERROR_LOOPER_ERROR : AdmitLocked(context, &victims);
+    if (ret == TFW_SUCCESS && context->stop == 1) {
+        TFW_LooperStatsOnPostFailed(&context->stats, 1);
+        ret = TFW_ERROR_LOOPER_ERROR;
+    }
+    if (ret == TFW_ERROR_LOOPER_ERROR) {
+        TFW_LOGE_UTILS("PostMessageAtTime stop is 1. name=%s, running=%d",
+            context->name, context->running);
+    }
+    if (ret == TFW_SUCCESS) {
+        ret = EnqueueLocked(context, msgPost);
+        if (ret != TFW_SUCCESS) {
+            TFW_LooperStatsOnPostFailed(&context->stats, 1);
+        }
+    }
+    if (ret != TFW_SUCCESS) {
+        (void)TFW_Mutex_Unlock(&context->lock);
+        FreeVictims(&victims);
+        FreeTFWMsg(msgPost);
+        return ret;
+    }
+    TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_POST, msgPost, UptimeMicros());
+    WakeParkedForMessageLocked(context, msgPost);
+    (void)TFW_Mutex_Unlock(&context->lock);
+    FreeVictims(&victims);
+    return TFW_SUCCESS;
+}
+
+// 零延时消息快速路径：无锁入队，不持有looper锁
+static int32_t PostMessageNow(const TFW_Looper *looper, TFW_Message *msgPost)
+{
+    int32_t ret = PostMessageAtTimeParamVerify(looper, msgPost);
+    if (ret == TFW_SUCCESS) {
+        ret = EnsureLooperStarted(looper->context);
+    }
+    if (ret != TFW_SUCCESS) {
+        FreeTFWMsg(msgPost);
+        return ret;
+    }
+
+    TFW_LooperContext *context = looper->context;
+    if (context->stop == 1) {
+        TFW_LOGE_UTILS("PostMessageNow stop is 1. name=%s", context->name);
+        FreeTFWMsg(msgPost);
+        return TFW_ERROR_LOOPER_ERROR;
+    }
+
+    ret = Admit(context);
+    if (ret != TFW_SUCCESS) {
+        FreeTFWMsg(msgPost);
+        return ret;
+    }
+    // 入队后消息可能立即被执行和释放，先记录
+    TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_POST, msgPost, msgPost->time);
+    ClearRepeat(msgPost);
+    if (context->executor != NULL) {
+        SubmitMessageToExecutor(context, msgPost);
+        return TFW_SUCCESS;
+    }
+    TFW_ListInit(&msgPost->link.node);
+    msgPost->link.heapIndex = TIMER_HEAP_INVALID_INDEX;
+    msgPost->link.mergeKind = MESSAGE_MERGE_NONE;
+    MpscPush(context, msgPost);
+    WakeLooperIfParked(context);
+    return TFW_SUCCESS;
+}
+
+// 将校验通过的消息串成一条链，一次原子交换整体入队，一次唤醒
+static int32_t LooperPostMessageBatch(const TFW_Looper *looper, TFW_Message **msgs, uint32_t count)
+{
+    if (msgs == NULL || count == 0) {
+        TFW_LOGE_UTILS("LooperPostMessageBatch with empty msgs");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (looper == NULL) {
+        TFW_LOGE_UTILS("LooperPostMessageBatch with nulllooper");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+
+    TFW_LooperContext *context = looper->context;
+    TFW_Message *first = NULL;
+    TFW_Message *last = NULL;
+    int32_t ret = TFW_SUCCESS;
+    int32_t startRet = EnsureLooperStarted(context);
+    int64_t now = UptimeMicros();
+    for (uint32_t i = 0; i < count; i++) {
+        TFW_Message *msg = msgs[i];
+        if (msg == NULL) {
+            continue;
+        }
+        msg->time = now;
+        int32_t msgRet = PostMessageAtTimeParamVerify(looper, msg);
+        if (msgRet == TFW_SUCCESS) {
+            msgRet = startRet;
+        }
+        if (msgRet == TFW_SUCCESS) {
+            msgRet = (context->stop == 1) ? TFW_ERROR_LOOPER_ERROR : Admit(context);
+        }
+        if (msgRet != TFW_SUCCESS) {
+            FreeTFWMsg(msg);
+            ret = msgRet;
+            continue;
+        }
+        TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_POST, msg, now);
+        ClearRepeat(msg);
+        if (context->executor != NULL) {
+            SubmitMessageToExecutor(context, msg);
+            continue;
+        }
+        TFW_ListInit(&msg->link.node);
+        msg->link.heapIndex = TIMER_HEAP_INVALID_INDEX;
+        msg->link.mergeKind = MESSAGE_MERGE_NONE;
+        TFW_AtomicStorePtr(&msg->link.next, NULL);
+        if (last == NULL) {
+            first = msg;
+        } else {
+            TFW_AtomicStorePtr(&last->link.next, msg);
+        }
+        last = msg;
+    }
+    if (first == NULL) {
+        return ret;
+    }
+    MpscPushChain(context, first, last);
+    WakeLooperIfParked(context);
+    return ret;
+}
+
+static int32_t LooperPostMessage(const TFW_Looper *looper, TFW_Message *msg)
+{
+    if (msg == NULL) {
+        TFW_LOGE_UTILS("LooperPostMessage with nullmsg");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (looper == NULL) {
+        TFW_LOGE_UTILS("LooperPostMessage with nulllooper");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    msg->time = UptimeMicros();
+    return PostMessageNow(looper, msg);
+}
+
+static int32_t LooperPostMessageDelay(const TFW_Looper *looper, TFW_Message *msg, uint64_t delayMillis)
+{
+    if (msg == NULL) {
+        TFW_LOGE_UTILS("LooperPostMessageDelay with nullmsg");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (looper == NULL) {
+        TFW_LOGE_UTILS("LooperPostMessageDelay with nulllooper");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (delayMillis == 0) {
+        msg->time = UptimeMicros();
+        return PostMessageNow(looper, msg);
+    }
+    msg->time = UptimeMicros() + (int64_t)delayMillis * TIME_THOUSANDS_MULTIPLIER;
+    ClearRepeat(msg);
+    return PostMessageAtTime(looper, msg);
+}
+
+static int32_t LooperPostMessageRepeating(const TFW_Looper *looper, TFW_Message *msg, uint64_t periodMs,
+    uint32_t flags)
+{
+    if (msg == NULL) {
+        TFW_LOGE_UTILS("LooperPostMessageRepeating with nullmsg");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (looper == NULL) {
+        TFW_LOGE_UTILS("LooperPostMessageRepeating with nulllooper");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (periodMs == 0) {
+        TFW_LOGE_UTILS("LooperPostMessageRepeating with zero period");
+        FreeTFWMsg(msg);
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    msg->link.periodUs = periodMs * TIME_THOUSANDS_MULTIPLIER;
+    msg->link.repeatFlags = flags;
+    msg->link.missedPeriods = 0;
+    msg->link.repeatState = MESSAGE_REPEAT_ARMED;
+    msg->time = UptimeMicros() + (int64_t)msg->link.periodUs;
+    return PostMessageAtTime(looper, msg);
+}
+
+// 在索引桶中查找同一投递方式、同一键且仍在排队的消息
+static TFW_Message *FindMergeableLocked(TFW_LooperContext *context, const TFW_Message *msg)
+{
+    TFW_ListNode *item = NULL;
+    TFW_LIST_FOR_EACH(item, MsgIndexBucket(context, msg->handler, msg->what)) {
+        TFW_Message *queued = TFW_LIST_ENTRY(item, TFW_Message, link.indexNode);
+        if (queued->handler == msg->handler && queued->what == msg->what &&
+            queued->link.mergeKind == msg->link.mergeKind && queued->link.mergeKey == msg->link.mergeKey) {
+            return queued;
+        }
+    }
+    return NULL;
+}
+
+// 新消息原位替换排队中的旧消息，沿用其执行时间、优先级、序号和队列位置
+static void ReplaceLocked(TFW_LooperContext *context, TFW_Message *old, TFW_Message *msg)
+{
+    msg->time = old->time;
+    msg->priority = old->priority;
+    msg->link.seq = old->link.seq;
+    msg->link.heapIndex = old->link.heapIndex;
+    if (old->link.heapIndex != TIMER_HEAP_INVALID_INDEX) {
+        LaneOf(context, old)->timerHeap[old->link.heapIndex] = msg;
+        TFW_ListInit(&msg->link.node);
+    } else {
+        TFW_ListAdd(&old->link.node, &msg->link.node);
+        TFW_ListDelete(&old->link.node);
+    }
+    TFW_ListAdd(&old->link.indexNode, &msg->link.indexNode);
+    TFW_ListDelete(&old->link.indexNode);
+    HandleIndexRemoveLocked(context, old);
+    HandleIndexInsertLocked(context, msg);
+    old->link.heapIndex = TIMER_HEAP_INVALID_INDEX;
+}
+
+// 存在可合并的旧消息时新消息只是顶替它，不占用额外容量；否则按容量策略准入
+static int32_t AdmitMergedLocked(TFW_LooperContext *context, const TFW_Message *msg, TFW_ListNode *victims)
+{
+    if (FindMergeableLocked(context, msg) != NULL) {
+        (void)TFW_LooperStatsOnPost(&context->stats, 1, 0);
+        return TFW_SUCCESS;
+    }
+    return AdmitLocked(context, victims);
+}
+
+// 合并与防抖投递都需要查找排队中的消息，统一走加锁路径；已移入分发批次的消息视为已开始执行，不参与合并
+static int32_t PostMessageMerged(const TFW_Looper *looper, TFW_Message *msg)
+{
+    int32_t ret = PostMessageAtTimeParamVerify(looper, msg);
+    if (ret == TFW_SUCCESS) {
+        ret = EnsureLooperStarted(looper->context);
+    }
+    if (ret != TFW_SUCCESS) {
+        FreeTFWMsg(msg);
+        return ret;
+    }
+    TFW_LooperContext *context = looper->context;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        FreeTFWMsg(msg);
+        return TFW_ERROR_LOCK_FAILED;
+    }
+    DrainMpscLocked(context);
+    TFW_LIST_HEAD(victims);
+    ret = (context->stop == 1) ? TFW_ERROR_LOOPER_ERROR : AdmitMergedLocked(context, msg, &victims);
+    if (ret == TFW_SUCCESS && context->stop == 1) {
+        TFW_LooperStatsOnPostFailed(&context->stats, 1);
+        ret = TFW_ERROR_LOOPER_ERROR;
+    }
+    if (ret != TFW_SUCCESS) {
+        (void)TFW_Mutex_Unlock(&context->lock);
+        TFW_LOGE_UTILS("PostMessageMerged failed. name=%s, ret=%d", context->name, ret);
+        FreeVictims(&victims);
+        FreeTFWMsg(msg);
+        return ret;
+    }
+    // 阻塞准入期间可能有新的可合并消息入队，重新查找
+    TFW_Message *old = FindMergeableLocked(context, msg);
+    int64_t now = UptimeMicros();
+    if (old != NULL) {
+        TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_REMOVE, old, now);
+    }
+    if (old != NULL && msg->link.mergeKind == MESSAGE_MERGE_COALESCED) {
+        ReplaceLocked(context, old, msg);
+    } else {
+        if (old != NULL) {
+            UnlinkLocked(context, old);
+        }
+        ret = EnqueueLocked(context, msg);
+        if (ret != TFW_SUCCESS) {
+            TFW_LooperStatsOnPostFailed(&context->stats, 1);
+            (void)TFW_Mutex_Unlock(&context->lock);
+            FreeVictims(&victims);
+            FreeTFWMsg(msg);
+            if (old != NULL) {
+                TFW_LooperStatsOnRemove(&context->stats, 1);
+                FreeTFWMsg(old);
+            }
+            return ret;
+        }
+    }
+    if (old != NULL) {
+        TFW_LooperStatsOnCoalesce(&context->stats);
+    }
+    TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_POST, msg, now);
+    WakeParkedForMessageLocked(context, msg);
+    (void)TFW_Mutex_Unlock(&context->lock);
+    FreeVictims(&victims);
+    if (old != NULL) {
+        FreeTFWMsg(old);
+    }
+    return TFW_SUCCESS;
+}
+
+static int32_t LooperPostMessageCoalesced(const TFW_Looper *looper, TFW_Message *msg, uint64_t key)
+{
+    if (msg == NULL) {
+        TFW_LOGE_UTILS("LooperPostMessageCoalesced with nullmsg");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (looper == NULL) {
+        TFW_LOGE_UTILS("LooperPostMessageCoalesced with nulllooper");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    msg->time = UptimeMicros();
+    msg->link.mergeKind = MESSAGE_MERGE_COALESCED;
+    ClearRepeat(msg);
+    msg->link.mergeKey = key;
+    return PostMessageMerged(looper, msg);
+}
+
+static int32_t LooperPostMessageDebounced(const TFW_Looper *looper, TFW_Message *msg, uint64_t windowMs)
+{
+    if (msg == NULL) {
+        TFW_LOGE_UTILS("LooperPostMessageDebounced with nullmsg");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (looper == NULL) {
+        TFW_LOGE_UTILS("LooperPostMessageDebounced with nulllooper");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    msg->time = UptimeMicros() + (int64_t)windowMs * TIME_THOUSANDS_MULTIPLIER;
+    msg->link.mergeKind = MESSAGE_MERGE_DEBOUNCED;
+    ClearRepeat(msg);
+    msg->link.mergeKey = 0;
+    return PostMessageMerged(looper, msg);
+}
+
+// 匹配则返回true，由调用者摘除后释放
+static bool RemoveMatchedLocked(TFW_LooperContext *context, const TFW_Message *msg,
+    const TFW_Handler *handler, int32_t (*customFunc)(const TFW_Message*, void*), void *args)
+{
+    if (msg->handler != handler || customFunc(msg, args) != 0) {
+        return false;
+    }
+    TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_REMOVE, msg, UptimeMicros());
+    return true;
+}
+
+// 摘除的消息挂到removed上，由调用者在锁外释放，释放回调可以再次投递到该looper
+static uint32_t RemoveFromLaneLocked(TFW_LooperContext *context, TFW_LooperLane *lane, const TFW_Handler *handler,
+    int32_t (*customFunc)(const TFW_Message*, void*), void *args, TFW_ListNode *removed)
+{
+    uint32_t removedCnt = 0;
+    TFW_ListNode *item = NULL;
+    TFW_ListNode *nextItem = NULL;
+    TFW_LIST_FOR_EACH_SAFE(item, nextItem, &lane->msgHead) {
+        TFW_Message *msg = TFW_LIST_ENTRY(item, TFW_Message, link.node);
+        if (RemoveMatchedLocked(context, msg, handler, customFunc, args)) {
+            UnlinkLocked(context, msg);
+            TFW_ListTailInsert(removed, &msg->link.node);
+            removedCnt++;
+        }
+    }
+    // 过滤定时堆后整体重建，O(n)
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < lane->timerHeapSize; i++) {
+        TFW_Message *msg = lane->timerHeap[i];
+        if (RemoveMatchedLocked(context, msg, handler, customFunc, args)) {
+            msg->link.heapIndex = TIMER_HEAP_INVALID_INDEX;
+            TFW_ListDelete(&msg->link.indexNode);
+            HandleIndexRemoveLocked(context, msg);
+            TFW_ListTailInsert(removed, &msg->link.node);
+            lane->msgSize--;
+            context->msgSize--;
+            removedCnt++;
+            continue;
+        }
+        TimerHeapSet(lane, kept++, msg);
+    }
+    if (kept != lane->timerHeapSize) {
+        lane->timerHeapSize = kept;
+        TimerHeapRebuild(lane);
+    }
+    return removedCnt;
+}
+
+static void LoopRemoveMessageCustom(const TFW_Looper *looper, const TFW_Handler *handler,
+    int32_t (*customFunc)(const TFW_Message*, void*), void *args)
+{
+    TFW_LooperContext *context = looper->context;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return;
+    }
+    if (context->running == 0 || context->stop == 1) {
+        (void)TFW_Mutex_Unlock(&context->lock);
+        return;
+    }
+    DrainMpscLocked(context);
+    TFW_LIST_HEAD(removed);
+    uint32_t removedCnt = 0;
+    // 分发批次中尚未执行的消息：先抢占状态再匹配，避免与looper线程同时访问
+    for (uint32_t i = 0; i < context->batchCount; i++) {
+        TFW_Message *msg = context->batch[i];
+        if (!TFW_AtomicCompareAndSwap32(&msg->link.state, MESSAGE_STATE_QUEUED, MESSAGE_STATE_INSPECTING)) {
+            continue;
+        }
+        bool matched = RemoveMatchedLocked(context, msg, handler, customFunc, args);
+        TFW_AtomicStore32(&msg->link.state, matched ? MESSAGE_STATE_CANCELLED : MESSAGE_STATE_QUEUED);
+        removedCnt += matched ? 1 : 0;
+    }
+    for (uint32_t i = 0; i < TFW_MSG_PRIORITY_MAX; i++) {
+        removedCnt += RemoveFromLaneLocked(context, &context->lanes[i], handler, customFunc, args, &removed);
+    }
+    if (removedCnt != 0) {
+        TFW_LooperStatsOnRemove(&context->stats, removedCnt);
+        NotifyNotFullLocked(context);
+    }
+    (void)TFW_Mutex_Unlock(&context->lock);
+    FreeVictims(&removed);
+}
+
+// 分发批次中尚未执行的(handler, what)消息，remove为true时取消，返回匹配数量
+static uint32_t MatchBatchByWhatLocked(TFW_LooperContext *context, const TFW_Handler *handler, int32_t what,
+    bool remove)
+{
+    uint32_t matched = 0;
+    for (uint32_t i = 0; i < context->batchCount; i++) {
+        TFW_Message *msg = context->batch[i];
+        if (!TFW_AtomicCompareAndSwap32(&msg->link.state, MESSAGE_STATE_QUEUED, MESSAGE_STATE_INSPECTING)) {
+            // 正在执行的重复消息不再重新放入定时堆
+            if (remove && msg->link.repeatState == MESSAGE_REPEAT_RUNNING &&
+                msg->handler == handler && msg->what == what) {
+                msg->link.repeatState = MESSAGE_REPEAT_CANCELLED;
+            }
+            continue;
+        }
+        bool hit = (msg->handler == handler && msg->what == what);
+        if (hit && remove) {
+            TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_REMOVE, msg, UptimeMicros());
+        }
+        TFW_AtomicStore32(&msg->link.state, (hit && remove) ? MESSAGE_STATE_CANCELLED : MESSAGE_STATE_QUEUED);
+        matched += hit ? 1 : 0;
+    }
+    return matched;
+}
+
+// 通过(handler, what)索引定向移除，只遍历同一桶内的消息
+static void LooperRemoveMessage(const TFW_Looper *looper, const TFW_Handler *handler, int32_t what)
+{
+    TFW_LooperContext *context = looper->context;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return;
+    }
+    if (context->running == 0 || context->stop == 1) {
+        (void)TFW_Mutex_Unlock(&context->lock);
+        return;
+    }
+    DrainMpscLocked(context);
+    uint32_t removedCnt = MatchBatchByWhatLocked(context, handler, what, true);
+    TFW_LIST_HEAD(removed);
+    TFW_ListNode *bucket = MsgIndexBucket(context, handler, what);
+    TFW_ListNode *item = NULL;
+    TFW_ListNode *nextItem = NULL;
+    TFW_LIST_FOR_EACH_SAFE(item, nextItem, bucket) {
+        TFW_Message *msg = TFW_LIST_ENTRY(item, TFW_Message, link.indexNode);
+        if (msg->handler != handler || msg->what != what) {
+            continue;
+        }
+        TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_REMOVE, msg, UptimeMicros());
+        UnlinkLocked(context, msg);
+        TFW_ListTailInsert(&removed, &msg->link.node);
+        removedCnt++;
+    }
+    if (removedCnt != 0) {
+        TFW_LooperStatsOnRemove(&context->stats, removedCnt);
+        NotifyNotFullLocked(context);
+    }
+    (void)TFW_Mutex_Unlock(&context->lock);
+    FreeVictims(&removed);
+}
+
+static bool LooperHasMessage(const TFW_Looper *looper, const TFW_Handler *handler, int32_t what)
+{
+    if (looper == NULL || looper->context == NULL) {
+        return false;
+    }
+    TFW_LooperContext *context = looper->context;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return false;
+    }
+    DrainMpscLocked(context);
+    bool found = (MatchBatchByWhatLocked(context, handler, what, false) != 0);
+    TFW_ListNode *item = NULL;
+    TFW_ListNode *bucket = MsgIndexBucket(context, handler, what);
+    TFW_LIST_FOR_EACH(item, bucket) {
+        if (found) {
+            break;
+        }
+        const TFW_Message *msg = TFW_LIST_ENTRY(item, TFW_Message, link.indexNode);
+        found = (msg->handler == handler && msg->what == what);
+    }
+    (void)TFW_Mutex_Unlock(&context->lock);
+    return found;
+}
+
+void TFW_SetLooperDumpable(TFW_Looper *loop, bool dumpable)
+{
+    if (loop == NULL) {
+        TFW_LOGE_UTILS("loop is null");
+        return;
+    }
+    loop->dumpable = dumpable;
+    if (loop->context != NULL) {
+        TFW_LooperTraceSetEnabled(&loop->context->trace, dumpable);
+    }
+}
+
+void TFW_LooperAttr_Init(TFW_LooperAttr *attr)
+{
+    if (attr == NULL) {
+        return;
+    }
+    attr->executor = NULL;
+    attr->capacity = 0;
+    attr->fullPolicy = TFW_LOOPER_FULL_REJECT;
+    attr->blockTimeoutMs = 0;
+    attr->backend = TFW_LOOPER_BACKEND_COND;
+    TFW_ThreadAttr_Init(&attr->threadAttr);
+    attr->lazyStart = false;
+    attr->timerSlackUs = 0;
+    attr->noThread = false;
+}
+
+TFW_Looper *TFW_CreateNewLooper(const char *name)
+{
+    return TFW_CreateNewLooperWithAttr(name, NULL);
+}
+
+TFW_Looper *TFW_CreateNewLooperWithAttr(const char *name, const TFW_LooperAttr *attr)
+{
+    TFW_Looper *looper = (TFW_Looper *)TFW_Calloc(sizeof(TFW_Looper));
+    if (looper == NULL) {
+        TFW_LOGE_UTILS("Looper TFW_Calloc fail");
+        return NULL;
     }
 
     TFW_LooperContext *context = (TFW_LooperContext *)TFW_Calloc(sizeof(TFW_LooperContext));
@@ -466,38 +2409,101 @@ TFW_Looper *TFW_CreateNewLooper(const char *name)
         TFW_Free(context);
         return NULL;
     }
-    TFW_ListInit(&context->msgHead);
+    if (MsgIndexInit(context) != TFW_SUCCESS || HandleIndexInit(context) != TFW_SUCCESS) {
+        TFW_LOGE_UTILS("msg index malloc fail");
+        TFW_Free(context->indexBuckets);
+        TFW_Free(context->handleBuckets);
+        TFW_Free(looper);
+        TFW_Free(context);
+        return NULL;
+    }
+    if (attr != NULL && attr->backend == TFW_LOOPER_BACKEND_EPOLL &&
+        TFW_LooperPollerCreate(&context->poller) != TFW_SUCCESS) {
+        TFW_LOGE_UTILS("looper poller create fail. name=%s", name);
+        TFW_Free(context->indexBuckets);
+        TFW_Free(context->handleBuckets);
+        TFW_Free(looper);
+        TFW_Free(context);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < TFW_MSG_PRIORITY_MAX; i++) {
+        TFW_ListInit(&context->lanes[i].msgHead);
+    }
+    TFW_ListInit(&context->fdEntries);
     // init context
     TFW_MutexAttr_Init(&context->attr);
     TFW_Mutex_Init(&context->lock, &context->attr);
+    TFW_Mutex_Init(&context->fdLock, &context->attr);
     // 初始化条件变量
     TFW_Cond_Init(&context->cond);
     TFW_Cond_Init(&context->condRunning);
+    TFW_Cond_Init(&context->condNotFull);
 
     // init looper
     context->stop = 0;
     context->running = 0;
-    context->currentMsg = NULL;
+    context->batchCount = 0;
+    context->executor = (attr != NULL) ? attr->executor : NULL;
+    TFW_AtomicStore32(&context->executorTasks, 0);
+    context->capacity = (attr != NULL) ? attr->capacity : 0;
+    context->fullPolicy = (attr != NULL) ? attr->fullPolicy : TFW_LOOPER_FULL_REJECT;
+    context->blockTimeoutMs = (attr != NULL) ? attr->blockTimeoutMs : 0;
     context->msgSize = 0;
+    context->postSeq = 0;
+    MpscInit(context);
+    TFW_AtomicStore32(&context->parked, 0);
+    context->parkDeadline = TFW_LOOPER_POLL_FOREVER;
+    context->timerSlackUs = (attr != NULL) ? (int64_t)attr->timerSlackUs : 0;
+    context->idleHandlerCnt = 0;
+    context->idlePending = true;
+    context->idleDeadline = TFW_LOOPER_POLL_FOREVER;
+    TFW_LooperTraceInit(&context->trace, true);
+    TFW_AtomicStore32(&context->started, 0);
+    if (attr != NULL) {
+        context->threadAttr = attr->threadAttr;
+    } else {
+        TFW_ThreadAttr_Init(&context->threadAttr);
+    }
+    context->looper = looper;
+    context->refs = 0;
+    context->registered = false;
 
     looper->context = context;
     looper->dumpable = true;
     looper->PostMessage = LooperPostMessage;
     looper->PostMessageDelay = LooperPostMessageDelay;
+    looper->PostMessageBatch = LooperPostMessageBatch;
     looper->RemoveMessage = LooperRemoveMessage;
     looper->RemoveMessageCustom = LoopRemoveMessageCustom;
-
-    int32_t ret = StartNewLooperThread(looper);
+    looper->HasMessage = LooperHasMessage;
+    looper->PostMessageCoalesced = LooperPostMessageCoalesced;
+    looper->PostMessageDebounced = LooperPostMessageDebounced;
+    looper->PostMessageRepeating = LooperPostMessageRepeating;
+
+    context->noThread = (attr != NULL) && attr->noThread;
+    context->driving = false;
+    TFW_AtomicStore32(&context->quit, 0);
+    int32_t ret = TFW_SUCCESS;
+    if (context->noThread) {
+        // 视为线程已启动，直到TFW_DestroyLooper才清除running
+        context->running = 1;
+        TFW_AtomicStore32(&context->started, 1);
+    } else if (attr == NULL || !attr->lazyStart) {
+        ret = EnsureLooperStarted(context);
+    }
     if (ret != 0) {
         TFW_LOGE_UTILS("start fail");
+        TFW_LooperPollerDestroy(context->poller);
+        TFW_Free(context->indexBuckets);
+        TFW_Free(context->handleBuckets);
         TFW_Free(looper);
         TFW_Free(context);
         return NULL;
     }
 
-    g_looperCnt++;
+    int32_t looperCnt = TFW_AtomicInc32(&g_looperCnt);
 
-    TFW_LOGD_UTILS("wait looper start ok. name=%s", context->name);
+    TFW_LOGD_UTILS("wait looper start ok. name=%s, count=%d", context->name, looperCnt);
     return looper;
 }
 
@@ -510,18 +2516,30 @@ void TFW_DestroyLooper(TFW_Looper *looper)
 
     TFW_LooperContext *context = looper->context;
     if (context != NULL) {
+        RegistryLock();
+        RegistryUnlinkLocked(context);
+        RegistryUnlock();
         (void)TFW_Mutex_Lock(&context->lock);
 
         TFW_LOGI_UTILS("set stop 1. name=%s", context->name);
         context->stop = 1;
 
         TFW_Cond_Broadcast(&context->cond);
+        TFW_Cond_Broadcast(&context->condNotFull);
+        if (context->poller != NULL) {
+            TFW_LooperPollerWakeup(context->poller);
+        }
         (void)TFW_Mutex_Unlock(&context->lock);
-        // 等待线程结束
+        // 等待线程结束、阻塞中的投递线程全部返回，以及已提交到执行器的消息全部执行完毕
         while (1) {
             (void)TFW_Mutex_Lock(&context->lock);
+            // 调用者驱动的looper没有线程可等待，等待正在进行的TFW_LooperRunOnce返回
+            if (context->noThread && !context->driving) {
+                context->running = 0;
+            }
             TFW_LOGI_UTILS("get. name=%s, running=%d", context->name, context->running);
-            if (context->running == 0) {
+            if (context->running == 0 && TFW_AtomicLoad32(&context->notFullWaiters) == 0 &&
+                TFW_AtomicLoad32(&context->executorTasks) == 0) {
                 (void)TFW_Mutex_Unlock(&context->lock);
                 break;
             }
@@ -530,20 +2548,45 @@ void TFW_DestroyLooper(TFW_Looper *looper)
             (void)TFW_Mutex_Unlock(&context->lock);
         }
         // release msg
+        (void)TFW_Mutex_Lock(&context->lock);
+        DrainMpscLocked(context);
+        (void)TFW_Mutex_Unlock(&context->lock);
+        for (uint32_t lane = 0; lane < TFW_MSG_PRIORITY_MAX; lane++) {
+            TFW_LooperLane *queue = &context->lanes[lane];
+            TFW_ListNode *item = NULL;
+            TFW_ListNode *nextItem = NULL;
+            TFW_LIST_FOR_EACH_SAFE(item, nextItem, &queue->msgHead) {
+                TFW_Message *msg = TFW_LIST_ENTRY(item, TFW_Message, link.node);
+                TFW_ListDelete(&msg->link.node);
+                FreeTFWMsg(msg);
+            }
+            for (uint32_t i = 0; i < queue->timerHeapSize; i++) {
+                FreeTFWMsg(queue->timerHeap[i]);
+            }
+            TFW_Free(queue->timerHeap);
+            queue->timerHeap = NULL;
+            queue->timerHeapSize = 0;
+        }
+        TFW_Free(context->indexBuckets);
+        context->indexBuckets = NULL;
+        TFW_Free(context->handleBuckets);
+        context->handleBuckets = NULL;
+        // 就绪消息已全部释放，剩余的注册只由注册本身持有
         TFW_ListNode *item = NULL;
         TFW_ListNode *nextItem = NULL;
-        TFW_LIST_FOR_EACH_SAFE(item, nextItem, &context->msgHead) {
-            TFW_MessageNode *itemNode = TFW_LIST_ENTRY(item, TFW_MessageNode, node);
-            TFW_Message *msg = itemNode->msg;
-            FreeTFWMsg(msg);
-            TFW_ListDelete(&itemNode->node);
-            TFW_Free(itemNode);
+        TFW_LIST_FOR_EACH_SAFE(item, nextItem, &context->fdEntries) {
+            TFW_ListDelete(item);
+            TFW_Free(TFW_LIST_ENTRY(item, TFW_LooperFdEntry, node));
         }
+        TFW_LooperPollerDestroy(context->poller);
+        context->poller = NULL;
         TFW_LOGI_UTILS("destroy. name=%s", context->name);
         // destroy looper
         // 销毁条件变量
         TFW_Cond_Destroy(&context->cond);
         TFW_Cond_Destroy(&context->condRunning);
+        TFW_Cond_Destroy(&context->condNotFull);
+        TFW_Mutex_Destroy(&context->fdLock);
         TFW_Mutex_Destroy(&context->lock);
         TFW_Free(context);
         looper->context = NULL;
@@ -552,9 +2595,197 @@ void TFW_DestroyLooper(TFW_Looper *looper)
     ReleaseLooper(looper);
 
     TFW_Free(looper);
-    if (g_looperCnt != 0) {
-        g_looperCnt--;
+    (void)TFW_AtomicDec32(&g_looperCnt);
+}
+
+TFW_Looper *TFW_LooperAcquire(const char *name, const TFW_LooperAttr *attr)
+{
+    if (name == NULL || strlen(name) >= LOOP_NAME_LEN) {
+        TFW_LOGE_UTILS("invalid looper name");
+        return NULL;
+    }
+    RegistryLock();
+    TFW_Looper *looper = RegistryFindLocked(name);
+    if (looper != NULL) {
+        looper->context->refs++;
+        RegistryUnlock();
+        return looper;
+    }
+    // 在注册表锁内创建，避免同名looper被并发创建两次
+    looper = TFW_CreateNewLooperWithAttr(name, attr);
+    if (looper != NULL && RegistryInsertLocked(looper) != TFW_SUCCESS) {
+        RegistryUnlock();
+        TFW_LOGE_UTILS("looper register fail. name=%s", name);
+        TFW_DestroyLooper(looper);
+        return NULL;
+    }
+    RegistryUnlock();
+    return looper;
+}
+
+TFW_Looper *TFW_LooperFind(const char *name)
+{
+    if (name == NULL) {
+        return NULL;
+    }
+    RegistryLock();
+    TFW_Looper *looper = RegistryFindLocked(name);
+    if (looper != NULL) {
+        looper->context->refs++;
+    }
+    RegistryUnlock();
+    return looper;
+}
+
+void TFW_LooperRelease(TFW_Looper *looper)
+{
+    if (looper == NULL || looper->context == NULL) {
+        return;
+    }
+    TFW_LooperContext *context = looper->context;
+    RegistryLock();
+    if (!context->registered) {
+        RegistryUnlock();
+        TFW_LOGE_UTILS("looper not registered. name=%s", context->name);
+        return;
+    }
+    if (--context->refs != 0) {
+        RegistryUnlock();
+        return;
+    }
+    RegistryUnlinkLocked(context);
+    RegistryUnlock();
+    TFW_DestroyLooper(looper);
+}
+
+int32_t TFW_LooperSetTimerSlack(const TFW_Looper *looper, uint32_t timerSlackUs)
+{
+    if (looper == NULL || looper->context == NULL) {
+        TFW_LOGE_UTILS("invalid looper");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    TFW_LooperContext *context = looper->context;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return TFW_ERROR_LOCK_FAILED;
+    }
+    context->timerSlackUs = (int64_t)timerSlackUs;
+    // 松弛变小时挂起的唤醒时刻可能过晚，唤醒后重新计算
+    WakeParkedLocked(context);
+    (void)TFW_Mutex_Unlock(&context->lock);
+    return TFW_SUCCESS;
+}
+
+// 持有lock时取消消息；release为true时消息已摘除，由调用者在锁外释放
+static int32_t CancelLocked(TFW_LooperContext *context, TFW_Message *msg, bool *release)
+{
+    int32_t ret = TFW_SUCCESS;
+    if (!TFW_IsListEmpty(&msg->link.indexNode)) {
+        // 仍在FIFO或定时堆中
+        UnlinkLocked(context, msg);
+        TFW_LooperStatsOnRemove(&context->stats, 1);
+        NotifyNotFullLocked(context);
+        *release = true;
+    } else if (msg->link.periodUs != 0) {
+        // 已取出尚未执行时直接取消；正在执行时在执行完毕后释放
+        if (msg->link.repeatState == MESSAGE_REPEAT_RUNNING) {
+            msg->link.repeatState = MESSAGE_REPEAT_CANCELLED;
+            if (context->executor == NULL &&
+                TFW_AtomicCompareAndSwap32(&msg->link.state, MESSAGE_STATE_QUEUED, MESSAGE_STATE_CANCELLED)) {
+                TFW_LooperStatsOnRemove(&context->stats, 1);
+                NotifyNotFullLocked(context);
+            }
+        } else {
+            ret = TFW_ERROR_NOT_FOUND;
+        }
+    } else if (TFW_AtomicCompareAndSwap32(&msg->link.state, MESSAGE_STATE_QUEUED, MESSAGE_STATE_CANCELLED)) {
+        // 在分发批次中尚未被looper线程认领；认领失败说明已开始执行
+        TFW_LooperStatsOnRemove(&context->stats, 1);
+        NotifyNotFullLocked(context);
+    } else {
+        ret = TFW_ERROR_NOT_FOUND;
+    }
+    if (ret == TFW_SUCCESS) {
+        TFW_LooperTraceRecord(&context->trace, TFW_LOOPER_TRACE_REMOVE, msg, UptimeMicros());
+    }
+    return ret;
+}
+
+int32_t TFW_LooperCancelRepeating(const TFW_Looper *looper, TFW_Message *msg)
+{
+    if (looper == NULL || looper->context == NULL || msg == NULL) {
+        TFW_LOGE_UTILS("invalid cancel param");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    TFW_LooperContext *context = looper->context;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return TFW_ERROR_LOCK_FAILED;
+    }
+    int32_t ret = TFW_ERROR_NOT_FOUND;
+    bool release = false;
+    if (msg->link.repeatState == MESSAGE_REPEAT_ARMED || msg->link.repeatState == MESSAGE_REPEAT_RUNNING) {
+        ret = CancelLocked(context, msg, &release);
+    }
+    (void)TFW_Mutex_Unlock(&context->lock);
+    if (release) {
+        FreeTFWMsg(msg);
+    }
+    return ret;
+}
+
+TFW_MessageHandle TFW_MessageGetHandle(TFW_Message *msg)
+{
+    if (msg == NULL) {
+        return TFW_MESSAGE_HANDLE_INVALID;
+    }
+    msg->link.handle = (uint64_t)TFW_AtomicInc64(&g_handleSeq);
+    return msg->link.handle;
+}
+
+int32_t TFW_LooperCancel(const TFW_Looper *looper, TFW_MessageHandle handle)
+{
+    if (looper == NULL || looper->context == NULL || handle == TFW_MESSAGE_HANDLE_INVALID) {
+        TFW_LOGE_UTILS("invalid cancel param");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    TFW_LooperContext *context = looper->context;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return TFW_ERROR_LOCK_FAILED;
+    }
+    // 无锁队列中的消息尚未加入句柄索引
+    DrainMpscLocked(context);
+    TFW_Message *msg = HandleIndexFindLocked(context, handle);
+    int32_t ret = TFW_ERROR_NOT_FOUND;
+    bool release = false;
+    if (msg != NULL) {
+        ret = CancelLocked(context, msg, &release);
+    }
+    (void)TFW_Mutex_Unlock(&context->lock);
+    if (release) {
+        FreeTFWMsg(msg);
+    }
+    return ret;
+}
+
+uint32_t TFW_MessageMissedPeriods(const TFW_Message *msg)
+{
+    return (msg != NULL) ? msg->link.missedPeriods : 0;
+}
+
+uint32_t TFW_GetLooperCount(void)
+{
+    int32_t looperCnt = TFW_AtomicLoad32(&g_looperCnt);
+    return (looperCnt > 0) ? (uint32_t)looperCnt : 0;
+}
+
+// 内置looper也可按名称查找，注册表持有的引用不会被释放
+static void RegisterBuiltinLooper(TFW_Looper *looper)
+{
+    RegistryLock();
+    if (RegistryFindLocked(looper->context->name) != NULL ||
+        RegistryInsertLocked(looper) != TFW_SUCCESS) {
+        TFW_LOGE_UTILS("register builtin looper fail. name=%s", looper->context->name);
     }
+    RegistryUnlock();
 }
 
 int32_t TFW_LooperInit(void)
@@ -565,6 +2796,7 @@ int32_t TFW_LooperInit(void)
         return TFW_ERROR_LOOPER_ERROR;
     }
     TFW_SetLooper(TFW_LOOP_TYPE_DEFAULT, defaultLooper);
+    RegisterBuiltinLooper(defaultLooper);
 
     TFW_Looper *logLooper = TFW_CreateNewLooper(TFW_LOG_LOOPER_NAME);
     if (!logLooper) {
@@ -572,6 +2804,31 @@ int32_t TFW_LooperInit(void)
         return TFW_ERROR_LOOPER_ERROR;
     }
     TFW_SetLooper(TFW_LOOP_TYPE_LOG, logLooper);
+    RegisterBuiltinLooper(logLooper);
+
+    // 维护任务只在串行looper空闲时执行，失败不影响消息循环
+    if (TFW_HousekeepingInit() != TFW_SUCCESS ||
+        TFW_HousekeepingAttach(defaultLooper) != TFW_SUCCESS ||
+        TFW_HousekeepingAttach(logLooper) != TFW_SUCCESS) {
+        TFW_LOGE_UTILS("init housekeeping fail.");
+    }
+
+    // 并发looper：工作线程数取自配置项system.max_threads
+    g_defaultExecutor = TFW_ExecutorCreate(TFW_DEFAULT_EXECUTOR_NAME, 0);
+    if (g_defaultExecutor == NULL) {
+        TFW_LOGE_UTILS("init default executor fail.");
+        return TFW_ERROR_LOOPER_ERROR;
+    }
+    TFW_LooperAttr attr;
+    TFW_LooperAttr_Init(&attr);
+    attr.executor = g_defaultExecutor;
+    TFW_Looper *concurrentLooper = TFW_CreateNewLooperWithAttr(TFW_CONCURRENT_LOOPER_NAME, &attr);
+    if (!concurrentLooper) {
+        TFW_LOGE_UTILS("init concurrent looper fail.");
+        return TFW_ERROR_LOOPER_ERROR;
+    }
+    TFW_SetLooper(TFW_LOOP_TYPE_CONCURRENT, concurrentLooper);
+    RegisterBuiltinLooper(concurrentLooper);
 
     TFW_LOGD_UTILS("init looper success.");
     return TFW_SUCCESS;
@@ -579,17 +2836,266 @@ int32_t TFW_LooperInit(void)
 
 void TFW_LooperDeinit(void)
 {
-    for (int32_t i = 0; i < (TFW_LOOP_TYPE_MAX); i++) {
-        if (g_looperConfig[i].looper == NULL) {
-            continue;
+    TFW_HousekeepingDeinit();
+    // 按创建的逆序销毁，并发looper最先销毁并等待其提交到执行器的消息执行完毕
+    for (int32_t i = TFW_LOOP_TYPE_MAX - 1; i >= 0; i--) {
+        if (g_looperConfig[i].looper != NULL) {
+            TFW_DestroyLooper(g_looperConfig[i].looper);
         }
-        (void)TFW_Mutex_Lock(&(g_looperConfig[i].looper->context->lock));
-        if (g_isThreadStarted == 0) {
-            g_isNeedDestroy = 1;
-            (void)TFW_Mutex_Unlock(&(g_looperConfig[i].looper->context->lock));
-            return;
+    }
+    // 使用执行器的looper均已销毁后再回收工作线程
+    if (g_defaultExecutor != NULL) {
+        TFW_ExecutorDestroy(g_defaultExecutor);
+        g_defaultExecutor = NULL;
+    }
+}
+
+int32_t TFW_LooperAddFd(const TFW_Looper *looper, int32_t fd, uint32_t events, TFW_Handler *handler)
+{
+    if (looper == NULL || looper->context == NULL) {
+        TFW_LOGE_UTILS("invalid looper");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    TFW_LooperContext *context = looper->context;
+    if (context->poller == NULL) {
+        TFW_LOGE_UTILS("looper backend not support fd. name=%s", context->name);
+        return TFW_ERROR_NOT_SUPPORTED;
+    }
+    if (fd < 0 || handler == NULL || (events & (TFW_LOOPER_FD_READ | TFW_LOOPER_FD_WRITE)) == 0) {
+        TFW_LOGE_UTILS("invalid fd param. fd=%d, events=%u", fd, events);
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    int32_t ret = EnsureLooperStarted(context);
+    if (ret != TFW_SUCCESS) {
+        return ret;
+    }
+    TFW_LooperFdEntry *entry = (TFW_LooperFdEntry *)TFW_Calloc(sizeof(TFW_LooperFdEntry));
+    if (entry == NULL) {
+        TFW_LOGE_UTILS("fd entry calloc fail");
+        return TFW_ERROR_MALLOC_ERR;
+    }
+    entry->fd = fd;
+    entry->events = events;
+    entry->handler = handler;
+    entry->context = context;
+    entry->refs = 1;
+    TFW_ListInit(&entry->node);
+
+    (void)TFW_Mutex_Lock(&context->fdLock);
+    if (FindFdEntryLocked(context, fd) != NULL) {
+        (void)TFW_Mutex_Unlock(&context->fdLock);
+        TFW_Free(entry);
+        TFW_LOGE_UTILS("fd already added. fd=%d", fd);
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    ret = TFW_LooperPollerAdd(context->poller, fd, events);
+    if (ret != TFW_SUCCESS) {
+        (void)TFW_Mutex_Unlock(&context->fdLock);
+        TFW_Free(entry);
+        TFW_LOGE_UTILS("poller add fail. fd=%d, ret=%d", fd, ret);
+        return ret;
+    }
+    TFW_ListTailInsert(&context->fdEntries, &entry->node);
+    (void)TFW_Mutex_Unlock(&context->fdLock);
+    return TFW_SUCCESS;
+}
+
+static int32_t MatchFdEntry(const TFW_Message *msg, void *args)
+{
+    return (msg->what == TFW_LOOPER_WHAT_FD_EVENT && msg->obj == args) ? 0 : 1;
+}
+
+int32_t TFW_LooperRemoveFd(const TFW_Looper *looper, int32_t fd)
+{
+    if (looper == NULL || looper->context == NULL) {
+        TFW_LOGE_UTILS("invalid looper");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    TFW_LooperContext *context = looper->context;
+    if (context->poller == NULL) {
+        return TFW_ERROR_NOT_SUPPORTED;
+    }
+    (void)TFW_Mutex_Lock(&context->fdLock);
+    TFW_LooperFdEntry *entry = FindFdEntryLocked(context, fd);
+    if (entry == NULL) {
+        (void)TFW_Mutex_Unlock(&context->fdLock);
+        return TFW_ERROR_NOT_FOUND;
+    }
+    entry->removed = true;
+    TFW_ListDelete(&entry->node);
+    (void)TFW_LooperPollerRemove(context->poller, fd);
+    (void)TFW_Mutex_Unlock(&context->fdLock);
+
+    // 丢弃尚未执行的就绪消息；正在执行的消息持有引用，释放时不再重新启用
+    LoopRemoveMessageCustom(looper, entry->handler, MatchFdEntry, entry);
+    (void)TFW_Mutex_Lock(&context->fdLock);
+    ReleaseFdEntryLocked(entry);
+    (void)TFW_Mutex_Unlock(&context->fdLock);
+    return TFW_SUCCESS;
+}
+
+// ============================================================================
+// 调用者线程驱动
+// Caller-driven loopers
+// ============================================================================
+
+static int32_t BeginDrive(TFW_LooperContext *context)
+{
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return TFW_ERROR_LOCK_FAILED;
+    }
+    int32_t ret = TFW_SUCCESS;
+    if (context->stop == 1) {
+        ret = TFW_ERROR_LOOPER_ERROR;
+    } else if (context->driving) {
+        TFW_LOGE_UTILS("looper is already driven by another call. name=%s", context->name);
+        ret = TFW_ERROR_LOOPER_ERROR;
+    } else {
+        context->driving = true;
+        // 驱动线程即looper线程，在该线程上阻塞投递按拒绝处理
+        context->threadId = TFW_GetThreadId();
+    }
+    (void)TFW_Mutex_Unlock(&context->lock);
+    return ret;
+}
+
+// 返回前释放已执行的批次并重新放入重复消息，不将其滞留到下一次驱动
+static void EndDrive(TFW_LooperContext *context)
+{
+    TFW_Message *done[LOOPER_DISPATCH_BATCH_MAX];
+    uint32_t doneCount = 0;
+    (void)TFW_Mutex_Lock(&context->lock);
+    RetireBatchLocked(context, done, &doneCount);
+    context->driving = false;
+    if (context->stop == 1) {
+        TFW_Cond_Broadcast(&context->condRunning);
+    }
+    (void)TFW_Mutex_Unlock(&context->lock);
+    for (uint32_t i = 0; i < doneCount; i++) {
+        FreeTFWMsg(done[i]);
+    }
+}
+
+static int32_t DriveParamVerify(const TFW_Looper *looper)
+{
+    if (looper == NULL || looper->context == NULL) {
+        TFW_LOGE_UTILS("invalid looper");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    if (!looper->context->noThread) {
+        TFW_LOGE_UTILS("looper owns a thread. name=%s", looper->context->name);
+        return TFW_ERROR_NOT_SUPPORTED;
+    }
+    return TFW_SUCCESS;
+}
+
+int32_t TFW_LooperRunOnce(const TFW_Looper *looper, int32_t timeoutMs)
+{
+    int32_t ret = DriveParamVerify(looper);
+    if (ret != TFW_SUCCESS) {
+        return ret;
+    }
+    TFW_LooperContext *context = looper->context;
+    ret = BeginDrive(context);
+    if (ret != TFW_SUCCESS) {
+        return ret;
+    }
+    int64_t waitUntil = (timeoutMs < 0) ? TFW_LOOPER_POLL_FOREVER :
+        UptimeMicros() + (int64_t)timeoutMs * TIME_THOUSANDS_MULTIPLIER;
+    // 空闲回调、描述符事件或虚假唤醒后继续等待，直到执行了消息或超时
+    for (;;) {
+        int32_t count = LoopIterate(looper, waitUntil);
+        if (count != 0) {
+            ret = (count < 0) ? TFW_ERROR_LOOPER_ERROR : count;
+            break;
+        }
+        if (TFW_AtomicCompareAndSwap32(&context->quit, 1, 0) ||
+            (waitUntil != TFW_LOOPER_POLL_FOREVER && UptimeMicros() >= waitUntil)) {
+            break;
+        }
+    }
+    EndDrive(context);
+    return ret;
+}
+
+int32_t TFW_LooperRun(const TFW_Looper *looper)
+{
+    int32_t ret = DriveParamVerify(looper);
+    if (ret != TFW_SUCCESS) {
+        return ret;
+    }
+    TFW_LooperContext *context = looper->context;
+    ret = BeginDrive(context);
+    if (ret != TFW_SUCCESS) {
+        return ret;
+    }
+    TFW_LOGI_UTILS("looper run on caller thread. name=%s", context->name);
+    for (;;) {
+        if (TFW_AtomicCompareAndSwap32(&context->quit, 1, 0)) {
+            break;
+        }
+        if (LoopIterate(looper, TFW_LOOPER_POLL_FOREVER) < 0) {
+            ret = TFW_ERROR_LOOPER_ERROR;
+            break;
         }
-        (void)TFW_Mutex_Unlock(&(g_looperConfig[i].looper->context->lock));
-        TFW_DestroyLooper(g_looperConfig[i].looper);
     }
+    EndDrive(context);
+    return ret;
+}
+
+int32_t TFW_LooperQuit(const TFW_Looper *looper)
+{
+    int32_t ret = DriveParamVerify(looper);
+    if (ret != TFW_SUCCESS) {
+        return ret;
+    }
+    TFW_LooperContext *context = looper->context;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return TFW_ERROR_LOCK_FAILED;
+    }
+    TFW_AtomicStore32(&context->quit, 1);
+    WakeParkedLocked(context);
+    (void)TFW_Mutex_Unlock(&context->lock);
+    return TFW_SUCCESS;
+}
+
+int32_t TFW_LooperAddIdleHandler(const TFW_Looper *looper, TFW_LooperIdleFunc func, void *arg)
+{
+    if (looper == NULL || looper->context == NULL || func == NULL) {
+        TFW_LOGE_UTILS("invalid looper or idle func");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    TFW_LooperContext *context = looper->context;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return TFW_ERROR_LOCK_FAILED;
+    }
+    if (context->idleHandlerCnt >= TFW_LOOPER_IDLE_HANDLER_MAX) {
+        (void)TFW_Mutex_Unlock(&context->lock);
+        TFW_LOGE_UTILS("idle handler full. name=%s", context->name);
+        return TFW_ERROR;
+    }
+    context->idleHandlers[context->idleHandlerCnt].func = func;
+    context->idleHandlers[context->idleHandlerCnt].arg = arg;
+    context->idleHandlers[context->idleHandlerCnt].deadline = TFW_LOOPER_POLL_FOREVER;
+    context->idleHandlerCnt++;
+    // 已挂起的looper立即执行一次新回调
+    context->idlePending = true;
+    WakeParkedLocked(context);
+    (void)TFW_Mutex_Unlock(&context->lock);
+    return TFW_SUCCESS;
+}
+
+int32_t TFW_LooperRemoveIdleHandler(const TFW_Looper *looper, TFW_LooperIdleFunc func, void *arg)
+{
+    if (looper == NULL || looper->context == NULL || func == NULL) {
+        TFW_LOGE_UTILS("invalid looper or idle func");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    TFW_LooperContext *context = looper->context;
+    if (TFW_Mutex_Lock(&context->lock) != 0) {
+        return TFW_ERROR_LOCK_FAILED;
+    }
+    bool removed = RemoveIdleEntryLocked(context, func, arg);
+    (void)TFW_Mutex_Unlock(&context->lock);
+    return removed ? TFW_SUCCESS : TFW_ERROR_NOT_FOUND;
 }
@@ -0,0 +1,53 @@
+#ifndef TFW_LOOPER_POLLER_H
+#define TFW_LOOPER_POLLER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// looper的I/O多路复用后端：一个唤醒描述符、一个截止时间定时器和任意数量的用户描述符
+// I/O multiplexing backend of looper: one wakeup fd, one deadline timer and user fds
+// ============================================================================
+
+// 无限等待
+#define TFW_LOOPER_POLL_FOREVER (-1)
+
+typedef struct TFW_LooperPoller TFW_LooperPoller;
+
+typedef struct {
+    int32_t fd;
+    uint32_t events;    // TFW_LOOPER_FD_*
+} TFW_LooperPollEvent;
+
+// 创建后端，不支持的平台返回TFW_ERROR_NOT_SUPPORTED
+int32_t TFW_LooperPollerCreate(TFW_LooperPoller **poller);
+
+void TFW_LooperPollerDestroy(TFW_LooperPoller *poller);
+
+// 唤醒正在等待的线程，可在任意线程调用；在等待开始前调用时下一次等待立即返回
+void TFW_LooperPollerWakeup(TFW_LooperPoller *poller);
+
+// 注册描述符，事件上报一次后自动停用，需调用Rearm重新启用
+int32_t TFW_LooperPollerAdd(TFW_LooperPoller *poller, int32_t fd, uint32_t events);
+
+int32_t TFW_LooperPollerRearm(TFW_LooperPoller *poller, int32_t fd, uint32_t events);
+
+int32_t TFW_LooperPollerRemove(TFW_LooperPoller *poller, int32_t fd);
+
+/**
+ * 等待描述符就绪、唤醒或截止时间到达
+ * Wait for fd readiness, wakeup or deadline
+ * @param deadlineUs 单调时钟微秒绝对时间，0表示不等待，TFW_LOOPER_POLL_FOREVER表示无限等待
+ * @return 就绪的用户描述符数量，负值表示错误
+ */
+int32_t TFW_LooperPollerWait(TFW_LooperPoller *poller, int64_t deadlineUs,
+    TFW_LooperPollEvent *events, uint32_t maxEvents);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TFW_LOOPER_POLLER_H
@@ -0,0 +1,81 @@
+#ifndef TFW_LOOPER_STATS_INNER_H
+#define TFW_LOOPER_STATS_INNER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "TFW_atomic.h"
+#include "TFW_message_loop.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 单个handler的统计槽位，handler指针作为键，首次执行时通过CAS占用
+typedef struct {
+    TFW_AtomicPtr handler;
+    TFW_AtomicInt32 ready;              // 名称写入完成后置1，快照只读取已就绪的槽位
+    char name[TFW_LOOPER_STATS_NAME_LEN];
+    TFW_AtomicInt64 count;
+    TFW_AtomicInt64 totalUs;
+    TFW_AtomicInt64 maxUs;
+    TFW_AtomicInt64 hist[TFW_LOOPER_HIST_BUCKETS];
+} TFW_LooperHandlerSlot;
+
+// looper内部统计计数器，均为原子变量，可在looper线程、执行器工作线程和投递线程上并发更新
+typedef struct {
+    TFW_AtomicInt64 posted;
+    TFW_AtomicInt64 dispatched;
+    TFW_AtomicInt64 removed;
+    TFW_AtomicInt64 coalesced;
+    TFW_AtomicInt64 dropped;
+    TFW_AtomicInt64 rejected;
+    TFW_AtomicInt64 blocked;
+    TFW_AtomicInt64 wakeups;
+    TFW_AtomicInt64 missedPeriods;
+    TFW_AtomicInt32 depth;
+    TFW_AtomicInt32 peakDepth;
+    TFW_AtomicInt64 delayMaxUs;
+    TFW_AtomicInt64 delayHist[TFW_LOOPER_HIST_BUCKETS];
+    TFW_LooperHandlerSlot handlers[TFW_LOOPER_STATS_MAX_HANDLERS];
+} TFW_LooperStatsCounter;
+
+// 投递count条消息并计入队列深度；capacity非0且深度将超过capacity时不计入并返回false
+bool TFW_LooperStatsOnPost(TFW_LooperStatsCounter *counter, uint32_t count, uint32_t capacity);
+
+// 已计入的投递未能入队（looper已停止、内存不足等），撤销OnPost
+void TFW_LooperStatsOnPostFailed(TFW_LooperStatsCounter *counter, uint32_t count);
+
+// 队列已满时丢弃消息；queued为true表示丢弃的是已排队的消息
+void TFW_LooperStatsOnDrop(TFW_LooperStatsCounter *counter, bool queued);
+
+// 队列已满时拒绝投递
+void TFW_LooperStatsOnReject(TFW_LooperStatsCounter *counter);
+
+// 队列已满时投递方开始阻塞等待
+void TFW_LooperStatsOnBlock(TFW_LooperStatsCounter *counter);
+
+// looper线程从挂起中返回
+void TFW_LooperStatsOnWakeup(TFW_LooperStatsCounter *counter);
+
+// 重复消息跳过count个周期
+void TFW_LooperStatsOnMissed(TFW_LooperStatsCounter *counter, uint32_t count);
+
+// 移除count条消息
+void TFW_LooperStatsOnRemove(TFW_LooperStatsCounter *counter, uint32_t count);
+
+// 排队中的消息被合并或防抖投递替换丢弃
+void TFW_LooperStatsOnCoalesce(TFW_LooperStatsCounter *counter);
+
+// 执行一条消息：delayUs为调度延迟，handleUs为HandleMessage耗时
+void TFW_LooperStatsOnDispatch(TFW_LooperStatsCounter *counter, const TFW_Handler *handler,
+    int64_t delayUs, int64_t handleUs);
+
+// 生成统计快照
+void TFW_LooperStatsSnapshot(TFW_LooperStatsCounter *counter, TFW_LooperStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TFW_LOOPER_STATS_INNER_H
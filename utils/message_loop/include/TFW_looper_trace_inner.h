@@ -0,0 +1,45 @@
+#ifndef TFW_LOOPER_TRACE_INNER_H
+#define TFW_LOOPER_TRACE_INNER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "TFW_atomic.h"
+#include "TFW_message_loop.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 单条事件：seq为写入序号+1，写入前清零、写完后发布，读取方前后两次比对seq丢弃被覆盖的槽位
+typedef struct {
+    TFW_AtomicInt64 seq;
+    TFW_AtomicInt64 timeUs;
+    TFW_AtomicInt64 arg1;
+    TFW_AtomicInt64 typeWhat;           // 高32位为事件类型，低32位为what
+    TFW_AtomicPtr handler;
+} TFW_LooperTraceSlot;
+
+// 多生产者环形缓冲区：投递线程、looper线程和执行器工作线程均可写入，写入位置通过原子递增分配
+typedef struct {
+    TFW_AtomicInt32 enabled;
+    TFW_AtomicInt64 head;               // 已分配的写入序号总数
+    TFW_LooperTraceSlot slots[TFW_LOOPER_TRACE_CAPACITY];
+} TFW_LooperTraceRing;
+
+void TFW_LooperTraceInit(TFW_LooperTraceRing *ring, bool enabled);
+
+void TFW_LooperTraceSetEnabled(TFW_LooperTraceRing *ring, bool enabled);
+
+// 记录一条事件，关闭追踪时只有一次原子读
+void TFW_LooperTraceRecord(TFW_LooperTraceRing *ring, TFW_LooperTraceType type, const TFW_Message *msg,
+    int64_t timeUs);
+
+// 按写入顺序拷贝仍有效的事件
+uint32_t TFW_LooperTraceCopy(TFW_LooperTraceRing *ring, TFW_LooperTraceEvent *events, uint32_t maxCnt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TFW_LOOPER_TRACE_INNER_H
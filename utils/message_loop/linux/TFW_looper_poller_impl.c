@@ -0,0 +1,202 @@
+#include "TFW_looper_poller.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "TFW_errorno.h"
+#include "TFW_mem.h"
+#include "TFW_message_loop.h"
+#include "TFW_utils_log.h"
+
+#define POLLER_EPOLL_EVENTS_MAX 64
+#define US_PER_SEC 1000000LL
+#define NS_PER_US 1000LL
+
+// ============================================================================
+// Linux平台实现：epoll + eventfd唤醒 + timerfd截止时间
+// Linux platform implementation: epoll + eventfd wakeup + timerfd deadline
+// ============================================================================
+
+struct TFW_LooperPoller {
+    int epollFd;
+    int wakeFd;
+    int timerFd;
+    int64_t armedDeadline;  // 当前timerfd的绝对到期时间，0表示未设置
+};
+
+static uint32_t ToEpollEvents(uint32_t events)
+{
+    uint32_t epollEvents = EPOLLONESHOT;
+    if ((events & TFW_LOOPER_FD_READ) != 0) {
+        epollEvents |= EPOLLIN;
+    }
+    if ((events & TFW_LOOPER_FD_WRITE) != 0) {
+        epollEvents |= EPOLLOUT;
+    }
+    return epollEvents;
+}
+
+static uint32_t FromEpollEvents(uint32_t epollEvents)
+{
+    uint32_t events = 0;
+    if ((epollEvents & EPOLLIN) != 0) {
+        events |= TFW_LOOPER_FD_READ;
+    }
+    if ((epollEvents & EPOLLOUT) != 0) {
+        events |= TFW_LOOPER_FD_WRITE;
+    }
+    if ((epollEvents & EPOLLERR) != 0) {
+        events |= TFW_LOOPER_FD_ERROR;
+    }
+    if ((epollEvents & (EPOLLHUP | EPOLLRDHUP)) != 0) {
+        events |= TFW_LOOPER_FD_HANGUP;
+    }
+    return events;
+}
+
+static int32_t AddInternalFd(int epollFd, int fd)
+{
+    struct epoll_event ev;
+    (void)memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    return (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == 0) ? TFW_SUCCESS : TFW_ERROR;
+}
+
+int32_t TFW_LooperPollerCreate(TFW_LooperPoller **poller)
+{
+    if (poller == NULL) {
+        return TFW_ERROR_INVALID_PARAM;
+    }
+    TFW_LooperPoller *p = (TFW_LooperPoller *)TFW_Calloc(sizeof(TFW_LooperPoller));
+    if (p == NULL) {
+        return TFW_ERROR_MALLOC_ERR;
+    }
+    p->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    p->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    p->timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (p->epollFd < 0 || p->wakeFd < 0 || p->timerFd < 0 ||
+        AddInternalFd(p->epollFd, p->wakeFd) != TFW_SUCCESS ||
+        AddInternalFd(p->epollFd, p->timerFd) != TFW_SUCCESS) {
+        TFW_LOGE_UTILS("looper poller create failed, errno=%d", errno);
+        TFW_LooperPollerDestroy(p);
+        return TFW_ERROR_INIT_FAIL;
+    }
+    *poller = p;
+    return TFW_SUCCESS;
+}
+
+void TFW_LooperPollerDestroy(TFW_LooperPoller *poller)
+{
+    if (poller == NULL) {
+        return;
+    }
+    if (poller->timerFd >= 0) {
+        (void)close(poller->timerFd);
+    }
+    if (poller->wakeFd >= 0) {
+        (void)close(poller->wakeFd);
+    }
+    if (poller->epollFd >= 0) {
+        (void)close(poller->epollFd);
+    }
+    TFW_Free(poller);
+}
+
+void TFW_LooperPollerWakeup(TFW_LooperPoller *poller)
+{
+    uint64_t one = 1;
+    // 计数器已满（EAGAIN）时等待方必然会被唤醒，忽略即可
+    (void)write(poller->wakeFd, &one, sizeof(one));
+}
+
+static int32_t ControlFd(TFW_LooperPoller *poller, int op, int32_t fd, uint32_t events)
+{
+    struct epoll_event ev;
+    (void)memset(&ev, 0, sizeof(ev));
+    ev.events = ToEpollEvents(events);
+    ev.data.fd = fd;
+    if (epoll_ctl(poller->epollFd, op, fd, &ev) != 0) {
+        TFW_LOGE_UTILS("epoll_ctl failed, op=%d, fd=%d, errno=%d", op, fd, errno);
+        return TFW_ERROR;
+    }
+    return TFW_SUCCESS;
+}
+
+int32_t TFW_LooperPollerAdd(TFW_LooperPoller *poller, int32_t fd, uint32_t events)
+{
+    return ControlFd(poller, EPOLL_CTL_ADD, fd, events);
+}
+
+int32_t TFW_LooperPollerRearm(TFW_LooperPoller *poller, int32_t fd, uint32_t events)
+{
+    return ControlFd(poller, EPOLL_CTL_MOD, fd, events);
+}
+
+int32_t TFW_LooperPollerRemove(TFW_LooperPoller *poller, int32_t fd)
+{
+    if (epoll_ctl(poller->epollFd, EPOLL_CTL_DEL, fd, NULL) != 0) {
+        return TFW_ERROR;
+    }
+    return TFW_SUCCESS;
+}
+
+// 截止时间未变化时不重复设置timerfd
+static void ArmDeadline(TFW_LooperPoller *poller, int64_t deadlineUs)
+{
+    if (deadlineUs == poller->armedDeadline) {
+        return;
+    }
+    struct itimerspec spec;
+    (void)memset(&spec, 0, sizeof(spec));
+    if (deadlineUs > 0) {
+        spec.it_value.tv_sec = deadlineUs / US_PER_SEC;
+        spec.it_value.tv_nsec = (deadlineUs % US_PER_SEC) * NS_PER_US;
+    }
+    if (timerfd_settime(poller->timerFd, TFD_TIMER_ABSTIME, &spec, NULL) == 0) {
+        poller->armedDeadline = deadlineUs;
+    }
+}
+
+static void DrainFd(int fd)
+{
+    uint64_t value = 0;
+    (void)read(fd, &value, sizeof(value));
+}
+
+int32_t TFW_LooperPollerWait(TFW_LooperPoller *poller, int64_t deadlineUs,
+    TFW_LooperPollEvent *events, uint32_t maxEvents)
+{
+    int timeoutMs = 0;
+    if (deadlineUs != 0) {
+        ArmDeadline(poller, (deadlineUs > 0) ? deadlineUs : 0);
+        timeoutMs = -1;
+    }
+    struct epoll_event ready[POLLER_EPOLL_EVENTS_MAX];
+    int maxReady = (maxEvents < POLLER_EPOLL_EVENTS_MAX) ? (int)maxEvents : POLLER_EPOLL_EVENTS_MAX;
+    int n = epoll_wait(poller->epollFd, ready, maxReady, timeoutMs);
+    if (n < 0) {
+        return (errno == EINTR) ? 0 : TFW_ERROR;
+    }
+    int32_t count = 0;
+    for (int i = 0; i < n; i++) {
+        int fd = ready[i].data.fd;
+        if (fd == poller->wakeFd) {
+            DrainFd(fd);
+            continue;
+        }
+        if (fd == poller->timerFd) {
+            DrainFd(fd);
+            poller->armedDeadline = 0;
+            continue;
+        }
+        events[count].fd = fd;
+        events[count].events = FromEpollEvents(ready[i].events);
+        count++;
+    }
+    return count;
+}
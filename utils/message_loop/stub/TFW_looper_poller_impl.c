@@ -0,0 +1,59 @@
+#include "TFW_looper_poller.h"
+
+#include "TFW_errorno.h"
+#include "TFW_utils_log.h"
+
+// ============================================================================
+// 不支持epoll的平台：looper只能使用条件变量后端
+// Platforms without epoll: looper only supports the condition variable backend
+// ============================================================================
+
+int32_t TFW_LooperPollerCreate(TFW_LooperPoller **poller)
+{
+    (void)poller;
+    TFW_LOGE_UTILS("looper poller is not supported on this platform");
+    return TFW_ERROR_NOT_SUPPORTED;
+}
+
+void TFW_LooperPollerDestroy(TFW_LooperPoller *poller)
+{
+    (void)poller;
+}
+
+void TFW_LooperPollerWakeup(TFW_LooperPoller *poller)
+{
+    (void)poller;
+}
+
+int32_t TFW_LooperPollerAdd(TFW_LooperPoller *poller, int32_t fd, uint32_t events)
+{
+    (void)poller;
+    (void)fd;
+    (void)events;
+    return TFW_ERROR_NOT_SUPPORTED;
+}
+
+int32_t TFW_LooperPollerRearm(TFW_LooperPoller *poller, int32_t fd, uint32_t events)
+{
+    (void)poller;
+    (void)fd;
+    (void)events;
+    return TFW_ERROR_NOT_SUPPORTED;
+}
+
+int32_t TFW_LooperPollerRemove(TFW_LooperPoller *poller, int32_t fd)
+{
+    (void)poller;
+    (void)fd;
+    return TFW_ERROR_NOT_SUPPORTED;
+}
+
+int32_t TFW_LooperPollerWait(TFW_LooperPoller *poller, int64_t deadlineUs,
+    TFW_LooperPollEvent *events, uint32_t maxEvents)
+{
+    (void)poller;
+    (void)deadlineUs;
+    (void)events;
+    (void)maxEvents;
+    return TFW_ERROR_NOT_SUPPORTED;
+}
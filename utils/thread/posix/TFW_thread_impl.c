@@ -1,8 +1,14 @@
 #include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
 #include <errno.h>
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
 
 #include "TFW_errorno.h"
 #include "TFW_thread.h"
@@ -265,6 +271,9 @@ int32_t TFW_ThreadAttr_Init(TFW_ThreadAttr* attr) {
     attr->name = NULL;
     attr->stackSize = 0;
     attr->priority = 0;
+    attr->policy = TFW_THREAD_SCHED_OTHER;
+    TFW_CpuSetZero(&attr->cpuSet);
+    attr->numaNode = TFW_THREAD_NUMA_NODE_ANY;
     return TFW_SUCCESS;
 }
 
@@ -273,6 +282,165 @@ int32_t TFW_ThreadAttr_Init(TFW_ThreadAttr* attr) {
 // POSIX platform thread implementation
 // ============================================================================
 
+#define NUMA_MAX_NODES 1024     // numaNode的上限，所有平台统一校验
+
+#if defined(__linux__)
+#define NUMA_CPULIST_PATH "/sys/devices/system/node/node%d/cpulist"
+#define NUMA_CPULIST_LEN 1024
+#define NUMA_MPOL_PREFERRED 1   // 同<numaif.h>中的MPOL_PREFERRED，避免依赖libnuma
+
+// 解析形如"0-3,8,10-11"的CPU列表
+static void ParseCpuList(const char* list, TFW_CpuSet* set) {
+    const char* cur = list;
+    while (*cur != '\0' && *cur != '\n') {
+        char* end = NULL;
+        unsigned long first = strtoul(cur, &end, 10);
+        if (end == cur) {
+            return;
+        }
+        unsigned long last = first;
+        if (*end == '-') {
+            cur = end + 1;
+            last = strtoul(cur, &end, 10);
+            if (end == cur) {
+                return;
+            }
+        }
+        for (unsigned long cpu = first; cpu <= last && cpu < TFW_THREAD_CPU_SET_SIZE; cpu++) {
+            TFW_CpuSetAdd(set, (uint32_t)cpu);
+        }
+        cur = (*end == ',') ? end + 1 : end;
+    }
+}
+
+static void LoadNumaNodeCpus(int32_t node, TFW_CpuSet* set) {
+    char path[64];
+    (void)snprintf(path, sizeof(path), NUMA_CPULIST_PATH, node);
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        TFW_LOGW_UTILS("numa node not found, node=%d", node);
+        return;
+    }
+    char list[NUMA_CPULIST_LEN];
+    if (fgets(list, sizeof(list), file) != NULL) {
+        ParseCpuList(list, set);
+    }
+    (void)fclose(file);
+}
+#endif
+
+// nice值和NUMA内存策略只作用于调用线程，需在新线程内设置
+typedef struct {
+    void* (*entry)(void*);
+    void* arg;
+    int32_t nice;
+    int32_t numaNode;
+} TFW_ThreadStartArgs;
+
+static void* ThreadStartTrampoline(void* param) {
+    TFW_ThreadStartArgs start = *(TFW_ThreadStartArgs*)param;
+    TFW_Free(param);
+#if defined(__linux__)
+    if (start.nice != 0 && setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), start.nice) != 0) {
+        TFW_LOGW_UTILS("TFW_Thread_Create setpriority failed, nice=%d, errno=%d", start.nice, errno);
+    }
+    if (start.numaNode != TFW_THREAD_NUMA_NODE_ANY && start.numaNode < NUMA_MAX_NODES) {
+        unsigned long nodeMask[NUMA_MAX_NODES / (8 * sizeof(unsigned long))] = {0};
+        nodeMask[start.numaNode / (8 * sizeof(unsigned long))] |= 1UL << (start.numaNode % (8 * sizeof(unsigned long)));
+        if (syscall(SYS_set_mempolicy, NUMA_MPOL_PREFERRED, nodeMask, NUMA_MAX_NODES) != 0) {
+            TFW_LOGW_UTILS("TFW_Thread_Create set_mempolicy failed, node=%d, errno=%d", start.numaNode, errno);
+        }
+    }
+#endif
+    return start.entry(start.arg);
+}
+
+static bool NeedStartArgs(const TFW_ThreadAttr* attr) {
+#if defined(__linux__)
+    return (attr->policy == TFW_THREAD_SCHED_OTHER && attr->priority != 0) ||
+        attr->numaNode != TFW_THREAD_NUMA_NODE_ANY;
+#else
+    (void)attr;
+    return false;
+#endif
+}
+
+static int ApplySchedParam(pthread_attr_t* pthreadAttr, const TFW_ThreadAttr* attr) {
+    int policy = (attr->policy == TFW_THREAD_SCHED_FIFO) ? SCHED_FIFO : SCHED_RR;
+    int ret = pthread_attr_setinheritsched(pthreadAttr, PTHREAD_EXPLICIT_SCHED);
+    if (ret == 0) {
+        ret = pthread_attr_setschedpolicy(pthreadAttr, policy);
+    }
+    if (ret != 0) {
+        return ret;
+    }
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    int minPriority = sched_get_priority_min(policy);
+    int maxPriority = sched_get_priority_max(policy);
+    param.sched_priority = (attr->priority < minPriority) ? minPriority :
+        ((attr->priority > maxPriority) ? maxPriority : attr->priority);
+    return pthread_attr_setschedparam(pthreadAttr, &param);
+}
+
+static int ApplyAffinity(pthread_attr_t* pthreadAttr, const TFW_ThreadAttr* attr) {
+    TFW_CpuSet cpus = attr->cpuSet;
+#if defined(__linux__)
+    if (TFW_CpuSetIsEmpty(&cpus) && attr->numaNode != TFW_THREAD_NUMA_NODE_ANY) {
+        LoadNumaNodeCpus(attr->numaNode, &cpus);
+    }
+    if (TFW_CpuSetIsEmpty(&cpus)) {
+        return 0;
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (uint32_t cpu = 0; cpu < TFW_THREAD_CPU_SET_SIZE && cpu < CPU_SETSIZE; cpu++) {
+        if (TFW_CpuSetHas(&cpus, cpu)) {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+    return pthread_attr_setaffinity_np(pthreadAttr, sizeof(cpuSet), &cpuSet);
+#else
+    if (!TFW_CpuSetIsEmpty(&cpus) || attr->numaNode != TFW_THREAD_NUMA_NODE_ANY) {
+        TFW_LOGW_UTILS("TFW_Thread_Create cpu affinity not supported on this platform, ignored");
+    }
+    return 0;
+#endif
+}
+
+static int CreateWithAttr(TFW_Thread_t* thread, const TFW_ThreadAttr* attr, bool realtime,
+                          void* (*entry)(void*), void* arg) {
+    pthread_attr_t pthreadAttr;
+    int ret = pthread_attr_init(&pthreadAttr);
+    if (ret != 0) {
+        TFW_LOGE_UTILS("TFW_Thread_Create pthread_attr_init failed, ret=%d", ret);
+        return ret;
+    }
+    if (attr->stackSize != 0) {
+        ret = pthread_attr_setstacksize(&pthreadAttr, attr->stackSize);
+        if (ret != 0) {
+            TFW_LOGE_UTILS("TFW_Thread_Create pthread_attr_setstacksize failed, ret=%d", ret);
+        }
+    }
+    if (ret == 0 && realtime) {
+        ret = ApplySchedParam(&pthreadAttr, attr);
+        if (ret != 0) {
+            TFW_LOGE_UTILS("TFW_Thread_Create set sched policy failed, ret=%d", ret);
+        }
+    }
+    if (ret == 0) {
+        ret = ApplyAffinity(&pthreadAttr, attr);
+        if (ret != 0) {
+            TFW_LOGE_UTILS("TFW_Thread_Create set affinity failed, ret=%d", ret);
+        }
+    }
+    if (ret == 0) {
+        ret = pthread_create((pthread_t*)thread, &pthreadAttr, entry, arg);
+    }
+    (void)pthread_attr_destroy(&pthreadAttr);
+    return ret;
+}
+
 int32_t TFW_Thread_Create(TFW_Thread_t* thread, const TFW_ThreadAttr* attr,
                             void* (*threadEntry)(void*), void* arg) {
     if (thread == NULL) {
@@ -285,6 +453,13 @@ int32_t TFW_Thread_Create(TFW_Thread_t* thread, const TFW_ThreadAttr* attr,
         return TFW_ERROR_INVALID_PARAM;
     }
 
+    // 负值节点会产生负的数组下标与移位数
+    if (attr != NULL && attr->numaNode != TFW_THREAD_NUMA_NODE_ANY &&
+        (attr->numaNode < 0 || attr->numaNode >= NUMA_MAX_NODES)) {
+        TFW_LOGE_UTILS("TFW_Thread_Create invalid numaNode=%d", attr->numaNode);
+        return TFW_ERROR_INVALID_PARAM;
+    }
+
     int32_t ret;
     if (attr == NULL) {
         ret = pthread_create((pthread_t*)thread, NULL, threadEntry, arg);
@@ -292,33 +467,42 @@ int32_t TFW_Thread_Create(TFW_Thread_t* thread, const TFW_ThreadAttr* attr,
             TFW_LOGE_UTILS("TFW_Thread_Create failed, ret=%d", ret);
             return TFW_ERROR;
         }
-    } else {
-        pthread_attr_t pthreadAttr;
-        ret = pthread_attr_init(&pthreadAttr);
-        if (ret != 0) {
-            TFW_LOGE_UTILS("TFW_Thread_Create pthread_attr_init failed, ret=%d", ret);
-            return TFW_ERROR;
-        }
+        return TFW_SUCCESS;
+    }
 
-        if (attr->stackSize != 0) {
-            ret = pthread_attr_setstacksize(&pthreadAttr, attr->stackSize);
-            if (ret != 0) {
-                TFW_LOGE_UTILS("TFW_Thread_Create pthread_attr_setstacksize failed, ret=%d", ret);
-                return TFW_ERROR;
-            }
+    void* (*entry)(void*) = threadEntry;
+    void* entryArg = arg;
+    TFW_ThreadStartArgs* start = NULL;
+    if (NeedStartArgs(attr)) {
+        start = (TFW_ThreadStartArgs*)TFW_Malloc(sizeof(TFW_ThreadStartArgs));
+        if (start == NULL) {
+            return TFW_ERROR_MALLOC_ERR;
         }
+        start->entry = threadEntry;
+        start->arg = arg;
+        start->nice = (attr->policy == TFW_THREAD_SCHED_OTHER) ? attr->priority : 0;
+        start->numaNode = attr->numaNode;
+        entry = ThreadStartTrampoline;
+        entryArg = start;
+    }
 
-        ret = pthread_create((pthread_t*)thread, &pthreadAttr, threadEntry, arg);
-        if (ret != 0) {
-            TFW_LOGE_UTILS("TFW_Thread_Create pthread_create failed, ret=%d", ret);
-            return TFW_ERROR;
-        }
+    bool realtime = (attr->policy != TFW_THREAD_SCHED_OTHER);
+    ret = CreateWithAttr(thread, attr, realtime, entry, entryArg);
+    if (ret == EPERM && realtime) {
+        // 无实时调度权限时退回默认策略，保证线程可以创建
+        TFW_LOGW_UTILS("TFW_Thread_Create realtime policy not permitted, fallback to default policy");
+        ret = CreateWithAttr(thread, attr, false, entry, entryArg);
+    }
+    if (ret != 0) {
+        TFW_LOGE_UTILS("TFW_Thread_Create pthread_create failed, ret=%d", ret);
+        TFW_Free(start);
+        return TFW_ERROR;
+    }
 
-        if (attr->name != NULL) {
-            ret = TFW_Thread_SetName(*thread, attr->name);
-            if (ret != 0) {
-                TFW_LOGE_UTILS("TFW_Thread_Create TFW_Thread_SetName failed, ret=%d", ret);
-            }
+    if (attr->name != NULL) {
+        ret = TFW_Thread_SetName(*thread, attr->name);
+        if (ret != 0) {
+            TFW_LOGE_UTILS("TFW_Thread_Create TFW_Thread_SetName failed, ret=%d", ret);
         }
     }
 
@@ -370,6 +554,36 @@ TFW_Thread_t TFW_Thread_GetSelf(void) {
     return (TFW_Thread_t)pthread_self();
 }
 
+// ============================================================================
+// POSIX平台线程局部键实现
+// POSIX platform thread key implementation
+// ============================================================================
+
+int32_t TFW_ThreadKey_Create(TFW_ThreadKey_t* key, void (*destructor)(void*)) {
+    if (key == NULL) {
+        TFW_LOGE_UTILS("TFW_ThreadKey_Create key is null");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+
+    pthread_key_t pkey;
+    int ret = pthread_key_create(&pkey, destructor);
+    if (ret != 0) {
+        TFW_LOGE_UTILS("TFW_ThreadKey_Create failed, ret=%d", ret);
+        return TFW_ERROR;
+    }
+    *key = (TFW_ThreadKey_t)pkey;
+    return TFW_SUCCESS;
+}
+
+int32_t TFW_ThreadKey_SetValue(TFW_ThreadKey_t key, void* value) {
+    int ret = pthread_setspecific((pthread_key_t)key, value);
+    if (ret != 0) {
+        TFW_LOGE_UTILS("TFW_ThreadKey_SetValue failed, ret=%d", ret);
+        return TFW_ERROR;
+    }
+    return TFW_SUCCESS;
+}
+
 // ============================================================================
 // POSIX平台进程和线程ID实现
 // POSIX platform process and thread ID implementation
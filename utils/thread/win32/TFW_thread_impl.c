@@ -209,6 +209,9 @@ int32_t TFW_ThreadAttr_Init(TFW_ThreadAttr* attr) {
     attr->name = NULL;
     attr->stackSize = 0;
     attr->priority = 0;
+    attr->policy = TFW_THREAD_SCHED_OTHER;
+    TFW_CpuSetZero(&attr->cpuSet);
+    attr->numaNode = TFW_THREAD_NUMA_NODE_ANY;
     return TFW_SUCCESS;
 }
 
@@ -296,6 +299,85 @@ TFW_Thread_t TFW_Thread_GetSelf(void) {
     return (TFW_Thread_t)GetCurrentThread();
 }
 
+// ============================================================================
+// Windows平台线程局部键实现
+// Windows platform thread key implementation
+// ============================================================================
+
+// FLS回调为WINAPI调用约定，不能直接使用调用者的destructor；每个线程的值连同destructor一起保存
+typedef struct {
+    DWORD index;
+    void (*destructor)(void*);
+} TFW_ThreadKeyImpl;
+
+typedef struct {
+    void (*destructor)(void*);
+    void* value;
+} TFW_ThreadKeySlot;
+
+static VOID WINAPI ThreadKeyCallback(PVOID data) {
+    TFW_ThreadKeySlot* slot = (TFW_ThreadKeySlot*)data;
+    if (slot == NULL) {
+        return;
+    }
+    void (*destructor)(void*) = slot->destructor;
+    void* value = slot->value;
+    TFW_Free(slot);
+    if (destructor != NULL && value != NULL) {
+        destructor(value);
+    }
+}
+
+int32_t TFW_ThreadKey_Create(TFW_ThreadKey_t* key, void (*destructor)(void*)) {
+    if (key == NULL) {
+        TFW_LOGE_UTILS("TFW_ThreadKey_Create key is null");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+
+    TFW_ThreadKeyImpl* impl = (TFW_ThreadKeyImpl*)TFW_Malloc(sizeof(TFW_ThreadKeyImpl));
+    if (impl == NULL) {
+        return TFW_ERROR_MALLOC_ERR;
+    }
+    impl->index = FlsAlloc(ThreadKeyCallback);
+    if (impl->index == FLS_OUT_OF_INDEXES) {
+        TFW_LOGE_UTILS("TFW_ThreadKey_Create FlsAlloc failed, error=%lu", GetLastError());
+        TFW_Free(impl);
+        return TFW_ERROR;
+    }
+    impl->destructor = destructor;
+    *key = (TFW_ThreadKey_t)impl;
+    return TFW_SUCCESS;
+}
+
+int32_t TFW_ThreadKey_SetValue(TFW_ThreadKey_t key, void* value) {
+    TFW_ThreadKeyImpl* impl = (TFW_ThreadKeyImpl*)key;
+    if (impl == NULL) {
+        TFW_LOGE_UTILS("TFW_ThreadKey_SetValue key is null");
+        return TFW_ERROR_INVALID_PARAM;
+    }
+
+    TFW_ThreadKeySlot* slot = (TFW_ThreadKeySlot*)FlsGetValue(impl->index);
+    if (value == NULL) {
+        (void)FlsSetValue(impl->index, NULL);
+        TFW_Free(slot);
+        return TFW_SUCCESS;
+    }
+    if (slot == NULL) {
+        slot = (TFW_ThreadKeySlot*)TFW_Malloc(sizeof(TFW_ThreadKeySlot));
+        if (slot == NULL) {
+            return TFW_ERROR_MALLOC_ERR;
+        }
+        if (!FlsSetValue(impl->index, slot)) {
+            TFW_LOGE_UTILS("TFW_ThreadKey_SetValue FlsSetValue failed, error=%lu", GetLastError());
+            TFW_Free(slot);
+            return TFW_ERROR;
+        }
+    }
+    slot->destructor = impl->destructor;
+    slot->value = value;
+    return TFW_SUCCESS;
+}
+
 // ============================================================================
 // Windows平台进程和线程ID实现
 // Windows platform process and thread ID implementation
@@ -91,7 +91,7 @@ int64_t TFW_GetTimestampUs() {
     struct timespec ts;
 #ifdef CLOCK_MONOTONIC
     if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
-        return (int64_t)(TFW_TIME_SEC_TO_US(ts.tv_sec) + TFW_TIME_NS_TO_MS(ts.tv_nsec));
+        return (int64_t)(TFW_TIME_SEC_TO_US(ts.tv_sec) + TFW_TIME_NS_TO_US(ts.tv_nsec));
     }
 #endif
 
@@ -102,7 +102,7 @@ int64_t TFW_GetTimestampUs() {
     struct timeval tv;
     struct timezone tz;
     gettimeofday(&tv, &tz);
-    return (int64_t)(TFW_TIME_SEC_TO_US(tv.tv_sec) + TFW_TIME_NS_TO_MS(tv.tv_usec));
+    return (int64_t)(TFW_TIME_SEC_TO_US(tv.tv_sec) + tv.tv_usec);
 }
 
 int64_t TFW_GetTimestampNs() {
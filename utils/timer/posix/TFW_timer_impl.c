@@ -75,7 +75,7 @@ int64_t TFW_GetTimestampUs() {
     // Linux/Unix platform: use clock_gettime() to get monotonic time
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (int64_t)(TFW_TIME_SEC_TO_US(ts.tv_sec) + TFW_TIME_NS_TO_MS(ts.tv_nsec));
+    return (int64_t)(TFW_TIME_SEC_TO_US(ts.tv_sec) + TFW_TIME_NS_TO_US(ts.tv_nsec));
 }
 
 int64_t TFW_GetTimestampNs() {